@@ -0,0 +1,38 @@
+@echo off
+rem Pavel Penkov 2025 All Rights Reserved.
+rem
+rem Headless performance captures of UHL Gym maps, see UUHLPerfCaptureSubsystem.
+rem Usage: RunGymPerfCaptures.bat <Path\To\UnrealEditor-Cmd.exe> <Path\To\Project.uproject> [OutputDir] [DurationSeconds]
+rem Results: <OutputDir>\<Gym>.csv (CSV profiler) and <OutputDir>\<Gym>_Summary.csv
+
+setlocal
+
+set EDITOR_CMD=%~1
+set PROJECT=%~2
+set OUTPUT_DIR=%~3
+set DURATION=%~4
+
+if "%EDITOR_CMD%"=="" goto usage
+if "%PROJECT%"=="" goto usage
+if "%OUTPUT_DIR%"=="" set OUTPUT_DIR=%~dp2Saved\Profiling\UHLPerfCapture\%DATE:/=-%
+if "%DURATION%"=="" set DURATION=30
+
+rem fixed frame rate, so simulation and results comparable between runs
+set COMMON_ARGS=-game -nullrhi -unattended -nosound -nosplash -benchmark -fps=30 -csvGpuStats=0 -UHLPerfCaptureWarmup=5 -UHLPerfCaptureDuration=%DURATION% -UHLPerfCaptureOutput="%OUTPUT_DIR%"
+
+set FAILED=0
+for %%G in (Gym_UHL_AI Gym_UHL_GAS Gym_UHL_InvokeGameplayAbility Gym_UHL_PlayAnimMontage_StressTest) do (
+	echo Capturing %%G...
+	"%EDITOR_CMD%" "%PROJECT%" /UnrealHelperLibrary/Gyms/%%G %COMMON_ARGS% -UHLPerfCapture=%%G -log=UHLPerfCapture_%%G.log
+	if errorlevel 1 (
+		echo %%G capture failed
+		set FAILED=1
+	)
+)
+
+echo Results in %OUTPUT_DIR%
+exit /b %FAILED%
+
+:usage
+echo Usage: RunGymPerfCaptures.bat ^<UnrealEditor-Cmd.exe^> ^<Project.uproject^> [OutputDir] [DurationSeconds]
+exit /b 1
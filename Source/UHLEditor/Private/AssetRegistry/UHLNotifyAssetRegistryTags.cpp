@@ -0,0 +1,148 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "AssetRegistry/UHLNotifyAssetRegistryTags.h"
+
+#include "Animation/AnimSequenceBase.h"
+#include "AssetRegistry/AssetData.h"
+#include "UObject/AssetRegistryTagsContext.h"
+#include "UObject/UnrealType.h"
+
+const FName FUHLNotifyAssetRegistryTags::NotifyClassesTag = TEXT("UHLNotifyClasses");
+const FName FUHLNotifyAssetRegistryTags::UniqueIdsTag = TEXT("UHLNotifyUniqueIds");
+const FName FUHLNotifyAssetRegistryTags::SoftReferencesTag = TEXT("UHLNotifySoftReferences");
+const FName FUHLNotifyAssetRegistryTags::DebugFlagsTag = TEXT("UHLNotifyDebugFlags");
+
+FDelegateHandle FUHLNotifyAssetRegistryTags::ExtraObjectTagsHandle;
+
+namespace UHLNotifyAssetRegistryTags
+{
+	static const TCHAR* Delimiter = TEXT("|");
+	static const FName UniqueIdPropertyName = TEXT("UniqueId");
+
+	FString JoinTagValues(TSet<FString>& Values)
+	{
+		Values.Sort(TLess<FString>());
+		return Delimiter + FString::Join(Values, Delimiter) + Delimiter;
+	}
+}
+
+void FUHLNotifyAssetRegistryTags::Register()
+{
+	ExtraObjectTagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.AddStatic(&FUHLNotifyAssetRegistryTags::OnGetExtraObjectTags);
+}
+
+void FUHLNotifyAssetRegistryTags::Unregister()
+{
+	UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.Remove(ExtraObjectTagsHandle);
+	ExtraObjectTagsHandle.Reset();
+}
+
+bool FUHLNotifyAssetRegistryTags::IsUHLNotifyClass(const UClass* Class)
+{
+	// blueprint notifies are UHL if their native parent is
+	const UClass* NativeClass = Class;
+	while (NativeClass && !NativeClass->HasAnyClassFlags(CLASS_Native))
+	{
+		NativeClass = NativeClass->GetSuperClass();
+	}
+	return NativeClass && NativeClass->GetOutermost()->GetFName() == TEXT("/Script/UnrealHelperLibrary");
+}
+
+void FUHLNotifyAssetRegistryTags::GetTagValues(const FAssetData& AssetData, FName Tag, TArray<FString>& OutValues)
+{
+	OutValues.Reset();
+
+	FString TagValue;
+	if (AssetData.GetTagValue(Tag, TagValue))
+	{
+		TagValue.ParseIntoArray(OutValues, UHLNotifyAssetRegistryTags::Delimiter, true);
+	}
+}
+
+bool FUHLNotifyAssetRegistryTags::TagContainsValue(const FAssetData& AssetData, FName Tag, const FString& Value)
+{
+	FString TagValue;
+	if (!AssetData.GetTagValue(Tag, TagValue))
+	{
+		return false;
+	}
+	return TagValue.Contains(UHLNotifyAssetRegistryTags::Delimiter + Value + UHLNotifyAssetRegistryTags::Delimiter);
+}
+
+void FUHLNotifyAssetRegistryTags::OnGetExtraObjectTags(FAssetRegistryTagsContext Context)
+{
+	const UAnimSequenceBase* Animation = Cast<UAnimSequenceBase>(Context.GetObject());
+	if (!Animation || Animation->HasAnyFlags(RF_ClassDefaultObject))
+	{
+		return;
+	}
+
+	TSet<FString> NotifyClasses;
+	TSet<FString> UniqueIds;
+	TSet<FString> SoftReferences;
+	TSet<FString> DebugFlags;
+
+	for (const FAnimNotifyEvent& NotifyEvent : Animation->Notifies)
+	{
+		const UObject* Notify = NotifyEvent.Notify ? static_cast<const UObject*>(NotifyEvent.Notify) : NotifyEvent.NotifyStateClass;
+		if (!Notify || !IsUHLNotifyClass(Notify->GetClass()))
+		{
+			continue;
+		}
+
+		const FString NotifyClassName = Notify->GetClass()->GetName();
+		NotifyClasses.Add(NotifyClassName);
+
+		for (TFieldIterator<FProperty> It(Notify->GetClass()); It; ++It)
+		{
+			const FProperty* Property = *It;
+			const void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Notify);
+
+			if (const FNameProperty* NameProperty = CastField<FNameProperty>(Property))
+			{
+				const FName Value = NameProperty->GetPropertyValue(ValuePtr);
+				if (Property->GetFName() == UHLNotifyAssetRegistryTags::UniqueIdPropertyName && !Value.IsNone())
+				{
+					UniqueIds.Add(Value.ToString());
+				}
+			}
+			// also covers soft class properties
+			else if (const FSoftObjectProperty* SoftObjectProperty = CastField<FSoftObjectProperty>(Property))
+			{
+				const FSoftObjectPath Path = SoftObjectProperty->GetPropertyValue(ValuePtr).ToSoftObjectPath();
+				if (!Path.IsNull())
+				{
+					SoftReferences.Add(Path.ToString());
+				}
+			}
+			else if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+			{
+				if (Property->GetName().Contains(TEXT("Debug")) && BoolProperty->GetPropertyValue(ValuePtr))
+				{
+					DebugFlags.Add(NotifyClassName + TEXT(".") + Property->GetName());
+				}
+			}
+		}
+	}
+
+	if (NotifyClasses.IsEmpty())
+	{
+		return;
+	}
+
+	using UHLNotifyAssetRegistryTags::JoinTagValues;
+	Context.AddTag(UObject::FAssetRegistryTag(NotifyClassesTag, JoinTagValues(NotifyClasses), UObject::FAssetRegistryTag::TT_Alphabetical));
+	if (!UniqueIds.IsEmpty())
+	{
+		Context.AddTag(UObject::FAssetRegistryTag(UniqueIdsTag, JoinTagValues(UniqueIds), UObject::FAssetRegistryTag::TT_Alphabetical));
+	}
+	if (!SoftReferences.IsEmpty())
+	{
+		Context.AddTag(UObject::FAssetRegistryTag(SoftReferencesTag, JoinTagValues(SoftReferences), UObject::FAssetRegistryTag::TT_Hidden));
+	}
+	if (!DebugFlags.IsEmpty())
+	{
+		Context.AddTag(UObject::FAssetRegistryTag(DebugFlagsTag, JoinTagValues(DebugFlags), UObject::FAssetRegistryTag::TT_Alphabetical));
+	}
+}
@@ -0,0 +1,68 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "AssetRegistry/UHLNotifyContentBrowserFilters.h"
+
+#include "AssetRegistry/UHLNotifyAssetRegistryTags.h"
+#include "ContentBrowserItem.h"
+#include "FrontendFilterBase.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLNotifyContentBrowserFilters)
+
+#define LOCTEXT_NAMESPACE "UHLNotifyContentBrowserFilters"
+
+class FUHLFrontendFilter_NotifyTag : public FFrontendFilter
+{
+public:
+	FUHLFrontendFilter_NotifyTag(TSharedPtr<FFrontendFilterCategory> InCategory, FName InTag, FString InName, FText InDisplayName, FText InToolTip)
+		: FFrontendFilter(InCategory)
+		, Tag(InTag)
+		, Name(MoveTemp(InName))
+		, DisplayName(MoveTemp(InDisplayName))
+		, ToolTip(MoveTemp(InToolTip))
+	{
+	}
+
+	virtual FString GetName() const override { return Name; }
+	virtual FText GetDisplayName() const override { return DisplayName; }
+	virtual FText GetToolTipText() const override { return ToolTip; }
+
+	virtual bool PassesFilter(FAssetFilterType InItem) const override
+	{
+		FAssetData AssetData;
+		return InItem.Legacy_TryGetAssetData(AssetData) && AssetData.TagsAndValues.Contains(Tag);
+	}
+
+private:
+	FName Tag;
+	FString Name;
+	FText DisplayName;
+	FText ToolTip;
+};
+
+void UUHLNotifyContentBrowserFilters::AddFrontEndFilterExtensions(TSharedPtr<FFrontendFilterCategory> DefaultCategory, TArray<TSharedRef<FFrontendFilter>>& InOutFilterList) const
+{
+	TSharedPtr<FFrontendFilterCategory> UHLCategory = MakeShareable(new FFrontendFilterCategory(
+		LOCTEXT("UHLCategoryName", "UHL"),
+		LOCTEXT("UHLCategoryTooltip", "Filter assets by UnrealHelperLibrary usage")));
+
+	InOutFilterList.Add(MakeShareable(new FUHLFrontendFilter_NotifyTag(UHLCategory,
+		FUHLNotifyAssetRegistryTags::NotifyClassesTag,
+		TEXT("UHLNotifies"),
+		LOCTEXT("UHLNotifiesName", "Uses UHL Notifies"),
+		LOCTEXT("UHLNotifiesTooltip", "Animations using UHL notifies/notify states"))));
+
+	InOutFilterList.Add(MakeShareable(new FUHLFrontendFilter_NotifyTag(UHLCategory,
+		FUHLNotifyAssetRegistryTags::UniqueIdsTag,
+		TEXT("UHLNotifyUniqueIds"),
+		LOCTEXT("UHLNotifyUniqueIdsName", "Uses UHL UniqueIds"),
+		LOCTEXT("UHLNotifyUniqueIdsTooltip", "Animations attaching/detaching actors by UniqueId, search specific one by \"UHLNotifyUniqueIds=Id\""))));
+
+	InOutFilterList.Add(MakeShareable(new FUHLFrontendFilter_NotifyTag(UHLCategory,
+		FUHLNotifyAssetRegistryTags::DebugFlagsTag,
+		TEXT("UHLNotifyDebugFlags"),
+		LOCTEXT("UHLNotifyDebugFlagsName", "UHL Notifies With Debug"),
+		LOCTEXT("UHLNotifyDebugFlagsTooltip", "Animations with UHL notifies that have debug enabled"))));
+}
+
+#undef LOCTEXT_NAMESPACE
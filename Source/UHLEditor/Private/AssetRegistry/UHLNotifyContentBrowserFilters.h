@@ -0,0 +1,19 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ContentBrowserFrontEndFilterExtension.h"
+#include "UHLNotifyContentBrowserFilters.generated.h"
+
+/**
+ * Content browser filters by UHL notify asset registry tags
+ */
+UCLASS()
+class UUHLNotifyContentBrowserFilters : public UContentBrowserFrontEndFilterExtension
+{
+	GENERATED_BODY()
+
+public:
+	virtual void AddFrontEndFilterExtensions(TSharedPtr<FFrontendFilterCategory> DefaultCategory, TArray<TSharedRef<FFrontendFilter>>& InOutFilterList) const override;
+};
@@ -0,0 +1,85 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "AssetRegistry/UHLNotifyUsageLibrary.h"
+
+#include "Animation/AnimSequenceBase.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/UHLNotifyAssetRegistryTags.h"
+#include "UObject/UObjectHash.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLNotifyUsageLibrary)
+
+TArray<FAssetData> UUHLNotifyUsageLibrary::FindAnimationsWithNotifyClass(TSubclassOf<UObject> NotifyClass, bool bIncludeChildClasses)
+{
+	if (!NotifyClass)
+	{
+		return {};
+	}
+
+	TArray<FString> ClassNames = { NotifyClass->GetName() };
+	if (bIncludeChildClasses)
+	{
+		TArray<UClass*> DerivedClasses;
+		GetDerivedClasses(NotifyClass, DerivedClasses);
+		for (const UClass* DerivedClass : DerivedClasses)
+		{
+			ClassNames.Add(DerivedClass->GetName());
+		}
+	}
+
+	return FindAnimationsWithTag(FUHLNotifyAssetRegistryTags::NotifyClassesTag, [&ClassNames](const FAssetData& AssetData)
+	{
+		return ClassNames.ContainsByPredicate([&AssetData](const FString& ClassName)
+		{
+			return FUHLNotifyAssetRegistryTags::TagContainsValue(AssetData, FUHLNotifyAssetRegistryTags::NotifyClassesTag, ClassName);
+		});
+	});
+}
+
+TArray<FAssetData> UUHLNotifyUsageLibrary::FindAnimationsWithUniqueId(FName UniqueId)
+{
+	const FString UniqueIdString = UniqueId.ToString();
+	return FindAnimationsWithTag(FUHLNotifyAssetRegistryTags::UniqueIdsTag, [&UniqueIdString](const FAssetData& AssetData)
+	{
+		return FUHLNotifyAssetRegistryTags::TagContainsValue(AssetData, FUHLNotifyAssetRegistryTags::UniqueIdsTag, UniqueIdString);
+	});
+}
+
+TArray<FAssetData> UUHLNotifyUsageLibrary::FindAnimationsReferencingAsset(const FSoftObjectPath& AssetPath)
+{
+	const FString AssetPathString = AssetPath.ToString();
+	return FindAnimationsWithTag(FUHLNotifyAssetRegistryTags::SoftReferencesTag, [&AssetPathString](const FAssetData& AssetData)
+	{
+		return FUHLNotifyAssetRegistryTags::TagContainsValue(AssetData, FUHLNotifyAssetRegistryTags::SoftReferencesTag, AssetPathString);
+	});
+}
+
+TArray<FAssetData> UUHLNotifyUsageLibrary::FindAnimationsWithDebugFlags()
+{
+	return FindAnimationsWithTag(FUHLNotifyAssetRegistryTags::DebugFlagsTag, [](const FAssetData&) { return true; });
+}
+
+bool UUHLNotifyUsageLibrary::GetNotifyUsage(const FAssetData& AnimationAssetData, TArray<FString>& OutNotifyClasses, TArray<FString>& OutUniqueIds,
+	TArray<FString>& OutSoftReferences, TArray<FString>& OutDebugFlags)
+{
+	FUHLNotifyAssetRegistryTags::GetTagValues(AnimationAssetData, FUHLNotifyAssetRegistryTags::NotifyClassesTag, OutNotifyClasses);
+	FUHLNotifyAssetRegistryTags::GetTagValues(AnimationAssetData, FUHLNotifyAssetRegistryTags::UniqueIdsTag, OutUniqueIds);
+	FUHLNotifyAssetRegistryTags::GetTagValues(AnimationAssetData, FUHLNotifyAssetRegistryTags::SoftReferencesTag, OutSoftReferences);
+	FUHLNotifyAssetRegistryTags::GetTagValues(AnimationAssetData, FUHLNotifyAssetRegistryTags::DebugFlagsTag, OutDebugFlags);
+	return !OutNotifyClasses.IsEmpty();
+}
+
+TArray<FAssetData> UUHLNotifyUsageLibrary::FindAnimationsWithTag(FName Tag, TFunctionRef<bool(const FAssetData&)> Predicate)
+{
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UAnimSequenceBase::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	// tag presence is enough, values are checked by predicate
+	Filter.TagsAndValues.Add(Tag, TOptional<FString>());
+
+	TArray<FAssetData> Result;
+	IAssetRegistry::GetChecked().GetAssets(Filter, Result);
+	Result.RemoveAllSwap([&Predicate](const FAssetData& AssetData) { return !Predicate(AssetData); });
+	return Result;
+}
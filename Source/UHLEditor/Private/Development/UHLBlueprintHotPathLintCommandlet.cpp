@@ -0,0 +1,71 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Development/UHLBlueprintHotPathLintCommandlet.h"
+
+#include "Development/UHLBlueprintHotPathLinter.h"
+#include "Engine/Blueprint.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLBlueprintHotPathLintCommandlet)
+
+DEFINE_LOG_CATEGORY_STATIC(LogUHLHotPathLint, Log, All);
+
+UUHLBlueprintHotPathLintCommandlet::UUHLBlueprintHotPathLintCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UUHLBlueprintHotPathLintCommandlet::Main(const FString& Params)
+{
+	FString Path = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Path="), Path);
+	FString CsvPath;
+	FParse::Value(*Params, TEXT("Csv="), CsvPath);
+	const bool bFailOnFindings = FParse::Param(*Params, TEXT("FailOnFindings"));
+
+	TArray<FAssetData> Assets;
+	UUHLBlueprintHotPathLinter::GetBlueprintAssets(Path, Assets);
+	UE_LOG(LogUHLHotPathLint, Display, TEXT("Linting %d blueprints in %s"), Assets.Num(), *Path);
+
+	TArray<FUHLHotPathLintFinding> Findings;
+	for (int32 i = 0; i < Assets.Num(); i++)
+	{
+		Findings.Append(UUHLBlueprintHotPathLinter::LintBlueprint(Cast<UBlueprint>(Assets[i].GetAsset())));
+
+		// keep memory flat on big projects
+		if (i % 100 == 99)
+		{
+			CollectGarbage(RF_NoFlags);
+		}
+	}
+
+	for (const FUHLHotPathLintFinding& Finding : Findings)
+	{
+		UE_LOG(LogUHLHotPathLint, Warning, TEXT("%s"), *Finding.ToString());
+	}
+	UE_LOG(LogUHLHotPathLint, Display, TEXT("%d findings"), Findings.Num());
+
+	if (!CsvPath.IsEmpty())
+	{
+		TArray<FString> Lines = { TEXT("Blueprint,Graph,Node,EntryPoint,EstimatedCost,Suggestion") };
+		for (const FUHLHotPathLintFinding& Finding : Findings)
+		{
+			Lines.Add(FString::Printf(TEXT("\"%s\",\"%s\",\"%s\",\"%s\",\"%s\",\"%s\""),
+				*Finding.BlueprintPath, *Finding.GraphName, *Finding.NodeTitle.Replace(TEXT("\""), TEXT("'")),
+				*Finding.EntryPoint, *Finding.EstimatedCost, *Finding.Suggestion));
+		}
+		if (FPaths::IsRelative(CsvPath))
+		{
+			CsvPath = FPaths::Combine(FPaths::ProjectDir(), CsvPath);
+		}
+		FFileHelper::SaveStringArrayToFile(Lines, *CsvPath);
+	}
+
+	return bFailOnFindings && !Findings.IsEmpty() ? 1 : 0;
+}
@@ -0,0 +1,355 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Development/UHLBlueprintHotPathLinter.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_CreateDelegate.h"
+#include "K2Node_CustomEvent.h"
+#include "K2Node_Event.h"
+#include "K2Node_FunctionEntry.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Logging/MessageLog.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Misc/UObjectToken.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLBlueprintHotPathLinter)
+
+#define LOCTEXT_NAMESPACE "UHLBlueprintHotPathLinter"
+
+const FName UUHLBlueprintHotPathLinter::MessageLogName = TEXT("UHLHotPathLinter");
+
+namespace UHLBlueprintHotPathLinter
+{
+	// Events/functions executed every frame
+	static const TSet<FName> HotEventNames = {
+		TEXT("ReceiveTick"),
+		TEXT("ReceiveTickAI"),
+		TEXT("Tick"),
+		TEXT("BlueprintUpdateAnimation"),
+		TEXT("BlueprintThreadSafeUpdateAnimation"),
+		TEXT("Received_NotifyTick"),
+	};
+
+	static const FName SetTimerByFunctionName = GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, K2_SetTimer);
+	static const FName SetTimerByEventName = GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, K2_SetTimerDelegate);
+
+	bool GetPinFloat(const UEdGraphNode* Node, FName PinName, float& OutValue)
+	{
+		const UEdGraphPin* Pin = Node->FindPin(PinName);
+		if (!Pin || Pin->LinkedTo.Num() > 0)
+		{
+			return false;
+		}
+		OutValue = FCString::Atof(*Pin->DefaultValue);
+		return true;
+	}
+}
+
+FString FUHLHotPathLintFinding::ToString() const
+{
+	return FString::Printf(TEXT("%s [%s] \"%s\" reachable from %s. Cost: %s. Suggestion: %s"),
+		*BlueprintPath, *GraphName, *NodeTitle, *EntryPoint, *EstimatedCost, *Suggestion);
+}
+
+const TMap<FName, UUHLBlueprintHotPathLinter::FCostRule>& UUHLBlueprintHotPathLinter::GetCostRules()
+{
+	static const TMap<FName, FCostRule> CostRules = {
+		{ TEXT("GetAssetsOfClass"), { TEXT("very high - asset registry query and sync load of every asset"), TEXT("get assets once on BeginPlay or use soft references"), NAME_None } },
+		{ TEXT("GetMostDistantVector"), { TEXT("high - navigation path query per point"), TEXT("disable bUseNavigation or cache result, refresh on timer"), TEXT("bUseNavigation") } },
+		{ TEXT("GetMostDistantActorComponent"), { TEXT("high - navigation path query per component"), TEXT("disable bUseNavigation or cache result, refresh on timer"), TEXT("bUseNavigation") } },
+		{ TEXT("DebugPrintStrings"), { TEXT("medium - string building and on screen message every call"), TEXT("remove from hot path or use DrawDebugBar graphs"), NAME_None } },
+		{ TEXT("DebugPrintString"), { TEXT("medium - on screen message every call"), TEXT("remove from hot path or use DrawDebugBar graphs"), NAME_None } },
+		{ TEXT("GetNamesOfComponentsOnObject"), { TEXT("high - reflection over class default subobjects and construction script"), TEXT("cache names on BeginPlay"), NAME_None } },
+		{ TEXT("GetActorComponentByName"), { TEXT("medium - iterates all components with string compare"), TEXT("cache component reference"), NAME_None } },
+		{ TEXT("GetSceneComponentByName"), { TEXT("medium - iterates all components with string compare"), TEXT("cache component reference"), NAME_None } },
+		{ TEXT("GetProjectVersion"), { TEXT("medium - config lookup"), TEXT("cache value"), NAME_None } },
+		{ TEXT("GetAllStreamingLevels"), { TEXT("medium - iterates levels and allocates array"), TEXT("cache, refresh on level streaming events"), NAME_None } },
+		{ TEXT("GetAllSubLevels"), { TEXT("medium - iterates levels and allocates array"), TEXT("cache, refresh on level streaming events"), NAME_None } },
+		{ TEXT("GetAllSubLevelPackageNames"), { TEXT("medium - iterates levels and builds strings"), TEXT("cache, refresh on level streaming events"), NAME_None } },
+		{ TEXT("ForceGarbageCollection"), { TEXT("very high - full GC hitch"), TEXT("never call from hot path, use loading screens"), NAME_None } },
+		{ TEXT("FlushLevelStreaming"), { TEXT("very high - blocks until streaming completes"), TEXT("never call from hot path, use loading screens"), NAME_None } },
+	};
+	return CostRules;
+}
+
+bool UUHLBlueprintHotPathLinter::IsUHLFunction(const UFunction* Function)
+{
+	return Function && Function->GetOutermost()->GetFName() == TEXT("/Script/UnrealHelperLibrary");
+}
+
+bool UUHLBlueprintHotPathLinter::IsBoolPinEnabled(const UEdGraphNode* Node, FName PinName)
+{
+	const UEdGraphPin* Pin = Node->FindPin(PinName, EGPD_Input);
+	return Pin && (Pin->LinkedTo.Num() > 0 || Pin->DefaultValue.Equals(TEXT("true"), ESearchCase::IgnoreCase));
+}
+
+TArray<FUHLHotPathLintFinding> UUHLBlueprintHotPathLinter::LintBlueprint(UBlueprint* Blueprint)
+{
+	TArray<FUHLHotPathLintFinding> Findings;
+	if (!Blueprint)
+	{
+		return Findings;
+	}
+
+	TArray<TPair<UEdGraphNode*, FString>> EntryPoints;
+	GatherEntryPoints(Blueprint, EntryPoints);
+	for (const TPair<UEdGraphNode*, FString>& EntryPoint : EntryPoints)
+	{
+		LintFromEntryPoint(Blueprint, EntryPoint.Key, EntryPoint.Value, Findings);
+	}
+	return Findings;
+}
+
+TArray<FUHLHotPathLintFinding> UUHLBlueprintHotPathLinter::LintBlueprintsInPath(const FString& Path)
+{
+	TArray<FAssetData> Assets;
+	GetBlueprintAssets(Path, Assets);
+
+	FScopedSlowTask SlowTask(Assets.Num(), LOCTEXT("LintingBlueprints", "Linting blueprint hot paths..."));
+	SlowTask.MakeDialog(true);
+
+	TArray<FUHLHotPathLintFinding> Findings;
+	for (const FAssetData& Asset : Assets)
+	{
+		if (SlowTask.ShouldCancel())
+		{
+			break;
+		}
+		SlowTask.EnterProgressFrame(1.0f, FText::FromName(Asset.AssetName));
+		Findings.Append(LintBlueprint(Cast<UBlueprint>(Asset.GetAsset())));
+	}
+	return Findings;
+}
+
+void UUHLBlueprintHotPathLinter::GetBlueprintAssets(const FString& Path, TArray<FAssetData>& OutAssets)
+{
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.PackagePaths.Add(*Path);
+	Filter.bRecursivePaths = true;
+	IAssetRegistry::GetChecked().GetAssets(Filter, OutAssets);
+}
+
+void UUHLBlueprintHotPathLinter::LintProjectAndShowMessageLog()
+{
+	const TArray<FUHLHotPathLintFinding> Findings = LintBlueprintsInPath(TEXT("/Game"));
+
+	FMessageLog MessageLog(MessageLogName);
+	MessageLog.NewPage(LOCTEXT("LintPage", "Blueprint Hot Paths"));
+	for (const FUHLHotPathLintFinding& Finding : Findings)
+	{
+		TSharedRef<FTokenizedMessage> Message = MessageLog.Warning();
+		Message->AddToken(FUObjectToken::Create(Finding.Node.Get(), FText::FromString(Finding.BlueprintPath)));
+		Message->AddToken(FTextToken::Create(FText::FromString(FString::Printf(TEXT("\"%s\" reachable from %s. Cost: %s. Suggestion: %s"),
+			*Finding.NodeTitle, *Finding.EntryPoint, *Finding.EstimatedCost, *Finding.Suggestion))));
+	}
+	if (Findings.IsEmpty())
+	{
+		MessageLog.Info(LOCTEXT("NoFindings", "No expensive UHL calls found on hot paths"));
+	}
+	MessageLog.Open(EMessageSeverity::Info, true);
+}
+
+void UUHLBlueprintHotPathLinter::GatherEntryPoints(UBlueprint* Blueprint, TArray<TPair<UEdGraphNode*, FString>>& OutEntryPoints)
+{
+	using namespace UHLBlueprintHotPathLinter;
+
+	TArray<UEdGraph*> Graphs;
+	Blueprint->GetAllGraphs(Graphs);
+
+	for (const UEdGraph* Graph : Graphs)
+	{
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			// events and overridden functions like BlueprintThreadSafeUpdateAnimation
+			if (const UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+			{
+				if (!EventNode->IsA<UK2Node_CustomEvent>() && HotEventNames.Contains(EventNode->EventReference.GetMemberName()))
+				{
+					OutEntryPoints.Emplace(Node, EventNode->EventReference.GetMemberName().ToString());
+				}
+				continue;
+			}
+			if (const UK2Node_FunctionEntry* FunctionEntry = Cast<UK2Node_FunctionEntry>(Node))
+			{
+				if (HotEventNames.Contains(FunctionEntry->FunctionReference.GetMemberName()))
+				{
+					OutEntryPoints.Emplace(Node, FunctionEntry->FunctionReference.GetMemberName().ToString());
+				}
+				continue;
+			}
+
+			// looping timers with constant short interval
+			const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node);
+			if (!CallNode)
+			{
+				continue;
+			}
+			const FName CalledFunctionName = CallNode->FunctionReference.GetMemberName();
+			if (CalledFunctionName != SetTimerByFunctionName && CalledFunctionName != SetTimerByEventName)
+			{
+				continue;
+			}
+
+			float Time = 0.0f;
+			if (!GetPinFloat(CallNode, TEXT("Time"), Time) || Time >= MaxHotTimerInterval || !IsBoolPinEnabled(CallNode, TEXT("bLooping")))
+			{
+				continue;
+			}
+
+			FName TimerFunctionName = NAME_None;
+			UEdGraphNode* TimerEntry = nullptr;
+			if (CalledFunctionName == SetTimerByFunctionName)
+			{
+				if (const UEdGraphPin* FunctionNamePin = CallNode->FindPin(TEXT("FunctionName")))
+				{
+					TimerFunctionName = *FunctionNamePin->DefaultValue;
+				}
+			}
+			else if (const UEdGraphPin* DelegatePin = CallNode->FindPin(TEXT("Delegate")))
+			{
+				for (const UEdGraphPin* LinkedPin : DelegatePin->LinkedTo)
+				{
+					UEdGraphNode* LinkedNode = LinkedPin->GetOwningNode();
+					if (LinkedNode->IsA<UK2Node_CustomEvent>())
+					{
+						TimerEntry = LinkedNode;
+					}
+					else if (const UK2Node_CreateDelegate* CreateDelegateNode = Cast<UK2Node_CreateDelegate>(LinkedNode))
+					{
+						TimerFunctionName = CreateDelegateNode->GetFunctionName();
+					}
+				}
+			}
+
+			if (!TimerEntry && !TimerFunctionName.IsNone())
+			{
+				TimerEntry = FindFunctionEntry(Blueprint, TimerFunctionName);
+			}
+			if (TimerEntry)
+			{
+				OutEntryPoints.Emplace(TimerEntry, FString::Printf(TEXT("looping timer %.3fs"), Time));
+			}
+		}
+	}
+}
+
+UEdGraphNode* UUHLBlueprintHotPathLinter::FindFunctionEntry(UBlueprint* Blueprint, FName FunctionName)
+{
+	for (const UEdGraph* FunctionGraph : Blueprint->FunctionGraphs)
+	{
+		if (FunctionGraph->GetFName() != FunctionName)
+		{
+			continue;
+		}
+		for (UEdGraphNode* Node : FunctionGraph->Nodes)
+		{
+			if (Node->IsA<UK2Node_FunctionEntry>())
+			{
+				return Node;
+			}
+		}
+	}
+
+	for (const UEdGraph* UbergraphPage : Blueprint->UbergraphPages)
+	{
+		for (UEdGraphNode* Node : UbergraphPage->Nodes)
+		{
+			const UK2Node_CustomEvent* CustomEvent = Cast<UK2Node_CustomEvent>(Node);
+			if (CustomEvent && CustomEvent->CustomFunctionName == FunctionName)
+			{
+				return Node;
+			}
+		}
+	}
+	return nullptr;
+}
+
+void UUHLBlueprintHotPathLinter::LintFromEntryPoint(UBlueprint* Blueprint, UEdGraphNode* EntryNode, const FString& EntryPointName, TArray<FUHLHotPathLintFinding>& OutFindings)
+{
+	TSet<const UEdGraphNode*> Visited;
+	TArray<UEdGraphNode*> Stack = { EntryNode };
+
+	while (!Stack.IsEmpty())
+	{
+		UEdGraphNode* Node = Stack.Pop(EAllowShrinking::No);
+		if (!Node || Visited.Contains(Node))
+		{
+			continue;
+		}
+		Visited.Add(Node);
+
+		if (const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node))
+		{
+			LintCall(Blueprint, CallNode, EntryPointName, OutFindings);
+
+			// step into blueprint's own functions
+			if (CallNode->FunctionReference.IsSelfContext())
+			{
+				Stack.Add(FindFunctionEntry(Blueprint, CallNode->FunctionReference.GetMemberName()));
+			}
+		}
+
+		for (const UEdGraphPin* Pin : Node->Pins)
+		{
+			const bool bExecPin = Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec;
+			for (const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				UEdGraphNode* LinkedNode = LinkedPin->GetOwningNode();
+				// execution continues by output exec pins, pure nodes evaluated by input data pins
+				const UK2Node* LinkedK2Node = Cast<UK2Node>(LinkedNode);
+				if ((bExecPin && Pin->Direction == EGPD_Output)
+					|| (!bExecPin && Pin->Direction == EGPD_Input && LinkedK2Node && LinkedK2Node->IsNodePure()))
+				{
+					Stack.Add(LinkedNode);
+				}
+			}
+		}
+	}
+}
+
+void UUHLBlueprintHotPathLinter::LintCall(UBlueprint* Blueprint, const UK2Node_CallFunction* CallNode, const FString& EntryPointName, TArray<FUHLHotPathLintFinding>& OutFindings)
+{
+	const UFunction* Function = CallNode->GetTargetFunction();
+	if (!IsUHLFunction(Function))
+	{
+		return;
+	}
+
+	FString EstimatedCost;
+	FString Suggestion;
+	if (const FCostRule* CostRule = GetCostRules().Find(Function->GetFName()))
+	{
+		if (CostRule->ConditionPinName.IsNone() || IsBoolPinEnabled(CallNode, CostRule->ConditionPinName))
+		{
+			EstimatedCost = CostRule->EstimatedCost;
+			Suggestion = CostRule->Suggestion;
+		}
+	}
+	if (EstimatedCost.IsEmpty() && (IsBoolPinEnabled(CallNode, TEXT("bDebug")) || IsBoolPinEnabled(CallNode, TEXT("bDrawDebug"))))
+	{
+		EstimatedCost = TEXT("medium - debug drawing every call");
+		Suggestion = TEXT("disable debug outside of investigation");
+	}
+	if (EstimatedCost.IsEmpty())
+	{
+		return;
+	}
+
+	FUHLHotPathLintFinding& Finding = OutFindings.AddDefaulted_GetRef();
+	Finding.BlueprintPath = Blueprint->GetPathName();
+	Finding.GraphName = CallNode->GetGraph() ? CallNode->GetGraph()->GetName() : FString();
+	Finding.NodeTitle = CallNode->GetNodeTitle(ENodeTitleType::ListView).ToString();
+	Finding.EntryPoint = EntryPointName;
+	Finding.EstimatedCost = MoveTemp(EstimatedCost);
+	Finding.Suggestion = MoveTemp(Suggestion);
+	Finding.Node = const_cast<UK2Node_CallFunction*>(CallNode);
+}
+
+#undef LOCTEXT_NAMESPACE
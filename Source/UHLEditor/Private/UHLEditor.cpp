@@ -7,6 +7,9 @@
 #include "ToolMenus.h"
 #include "UHLEditorBlueprintThumbnailRenderer.h"
 #include "ThumbnailRendering/ThumbnailManager.h"
+#include "AssetRegistry/UHLNotifyAssetRegistryTags.h"
+#include "Development/UHLBlueprintHotPathLinter.h"
+#include "MessageLogModule.h"
 
 static const FName UHLDebugSystemEditorTabName("UHLEditor");
 
@@ -32,6 +35,11 @@ void FUHLEditorModule::StartupModule()
 
     UThumbnailManager::Get().UnregisterCustomRenderer(UBlueprint::StaticClass());
     UThumbnailManager::Get().RegisterCustomRenderer(UBlueprint::StaticClass(), UUHLEditorBlueprintThumbnailRenderer::StaticClass());
+
+	FUHLNotifyAssetRegistryTags::Register();
+
+	FMessageLogModule& MessageLogModule = FModuleManager::LoadModuleChecked<FMessageLogModule>("MessageLog");
+	MessageLogModule.RegisterLogListing(UUHLBlueprintHotPathLinter::MessageLogName, LOCTEXT("HotPathLinterLogLabel", "UHL Blueprint Hot Paths"));
 }
 
 void FUHLEditorModule::ShutdownModule()
@@ -39,6 +47,12 @@ void FUHLEditorModule::ShutdownModule()
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
 
+	FUHLNotifyAssetRegistryTags::Unregister();
+	if (FModuleManager::Get().IsModuleLoaded("MessageLog"))
+	{
+		FModuleManager::GetModuleChecked<FMessageLogModule>("MessageLog").UnregisterLogListing(UUHLBlueprintHotPathLinter::MessageLogName);
+	}
+
 	UToolMenus::UnRegisterStartupCallback(this);
 
 	UToolMenus::UnregisterOwner(this);
@@ -72,6 +86,19 @@ void FUHLEditorModule::RegisterMenus()
 		}
 	}
 
+	{
+		UToolMenu* Menu = UToolMenus::Get()->ExtendMenu("LevelEditor.MainMenu.Tools");
+		{
+			FToolMenuSection& Section = Menu->FindOrAddSection("UHL", LOCTEXT("UHLToolsSection", "UHL"));
+			Section.AddMenuEntry(
+				"UHLLintBlueprintHotPaths",
+				LOCTEXT("LintBlueprintHotPaths", "Lint Blueprint Hot Paths"),
+				LOCTEXT("LintBlueprintHotPathsTooltip", "Find expensive UHL calls reachable from Tick, anim update and fast timers"),
+				FSlateIcon(),
+				FUIAction(FExecuteAction::CreateStatic(&UUHLBlueprintHotPathLinter::LintProjectAndShowMessageLog)));
+		}
+	}
+
 	{
 		UToolMenu* ToolbarMenu = UToolMenus::Get()->ExtendMenu("LevelEditor.LevelEditorToolBar.PlayToolBar");
 		{
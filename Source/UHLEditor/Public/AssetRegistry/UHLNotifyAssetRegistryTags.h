@@ -0,0 +1,40 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetData;
+class FAssetRegistryTagsContext;
+
+/**
+ * Writes summary of UHL notifies used by animation to asset registry tags on save,
+ * so montages/sequences can be searched by notify class/UniqueId without loading them.
+ *
+ * Tag values are delimited from both sides "|A|B|", so "|A|" can be searched by Contains.
+ * Content browser search also works e.g. "UHLNotifyUniqueIds=Sword".
+ * Animations saved before tags were added have to be resaved.
+ */
+struct UHLEDITOR_API FUHLNotifyAssetRegistryTags
+{
+	// Notify classes (native and blueprint) from UnrealHelperLibrary module and their children
+	static const FName NotifyClassesTag;
+	// Values of "UniqueId" properties
+	static const FName UniqueIdsTag;
+	// Soft object/class paths referenced by notifies, e.g. ActorToAttach
+	static const FName SoftReferencesTag;
+	// "NotifyClass.PropertyName" of enabled bool properties containing "Debug" in name
+	static const FName DebugFlagsTag;
+
+	static void Register();
+	static void Unregister();
+
+	static bool IsUHLNotifyClass(const UClass* Class);
+	static void GetTagValues(const FAssetData& AssetData, FName Tag, TArray<FString>& OutValues);
+	static bool TagContainsValue(const FAssetData& AssetData, FName Tag, const FString& Value);
+
+private:
+	static FDelegateHandle ExtraObjectTagsHandle;
+
+	static void OnGetExtraObjectTags(FAssetRegistryTagsContext Context);
+};
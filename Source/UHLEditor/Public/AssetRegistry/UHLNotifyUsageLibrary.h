@@ -0,0 +1,41 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "UHLNotifyUsageLibrary.generated.h"
+
+/**
+ * Queries over UHL notify usage written by FUHLNotifyAssetRegistryTags.
+ * Only asset registry read, no animation is loaded
+ */
+UCLASS()
+class UHLEDITOR_API UUHLNotifyUsageLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Child classes are searched only if they are loaded, native notifies always are
+	UFUNCTION(BlueprintCallable, Category = "UHL|NotifyUsage")
+	static TArray<FAssetData> FindAnimationsWithNotifyClass(TSubclassOf<UObject> NotifyClass, bool bIncludeChildClasses = true);
+
+	UFUNCTION(BlueprintCallable, Category = "UHL|NotifyUsage")
+	static TArray<FAssetData> FindAnimationsWithUniqueId(FName UniqueId);
+
+	// e.g. animations attaching specific actor class or prop data
+	UFUNCTION(BlueprintCallable, Category = "UHL|NotifyUsage")
+	static TArray<FAssetData> FindAnimationsReferencingAsset(const FSoftObjectPath& AssetPath);
+
+	UFUNCTION(BlueprintCallable, Category = "UHL|NotifyUsage")
+	static TArray<FAssetData> FindAnimationsWithDebugFlags();
+
+	// Returns false if animation has no UHL notifies or wasn't resaved since tags were added
+	UFUNCTION(BlueprintCallable, Category = "UHL|NotifyUsage")
+	static bool GetNotifyUsage(const FAssetData& AnimationAssetData, TArray<FString>& OutNotifyClasses, TArray<FString>& OutUniqueIds,
+		TArray<FString>& OutSoftReferences, TArray<FString>& OutDebugFlags);
+
+private:
+	static TArray<FAssetData> FindAnimationsWithTag(FName Tag, TFunctionRef<bool(const FAssetData&)> Predicate);
+};
@@ -0,0 +1,25 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UHLBlueprintHotPathLintCommandlet.generated.h"
+
+/**
+ * Runs UUHLBlueprintHotPathLinter over blueprints for CI.
+ *
+ * UnrealEditor-Cmd.exe Project.uproject -run=UHLBlueprintHotPathLint [-Path=/Game] [-Csv=Saved/HotPathLint.csv] [-FailOnFindings]
+ *
+ * Every finding logged as warning, returns 1 if "-FailOnFindings" and anything found
+ */
+UCLASS()
+class UHLEDITOR_API UUHLBlueprintHotPathLintCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UUHLBlueprintHotPathLintCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
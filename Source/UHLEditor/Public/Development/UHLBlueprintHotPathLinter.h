@@ -0,0 +1,88 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "UHLBlueprintHotPathLinter.generated.h"
+
+class UBlueprint;
+class UEdGraphNode;
+class UK2Node_CallFunction;
+
+USTRUCT(BlueprintType)
+struct FUHLHotPathLintFinding
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "HotPathLint")
+	FString BlueprintPath;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HotPathLint")
+	FString GraphName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HotPathLint")
+	FString NodeTitle;
+
+	// Tick/anim update/fast timer event from which node is reachable
+	UPROPERTY(BlueprintReadOnly, Category = "HotPathLint")
+	FString EntryPoint;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HotPathLint")
+	FString EstimatedCost;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HotPathLint")
+	FString Suggestion;
+
+	TWeakObjectPtr<UEdGraphNode> Node;
+
+	FString ToString() const;
+};
+
+/**
+ * Walks blueprint graphs from hot entry points (Tick, anim update, notify tick,
+ * looping timers faster than "MaxHotTimerInterval") and flags calls to UHL functions
+ * known to be expensive, or UHL functions called with debug enabled.
+ *
+ * Available from "Tools -> UHL -> Lint Blueprint Hot Paths" (results in message log),
+ * from editor utility widgets and by "UHLBlueprintHotPathLint" commandlet for CI
+ */
+UCLASS()
+class UHLEDITOR_API UUHLBlueprintHotPathLinter : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr float MaxHotTimerInterval = 0.1f;
+	static const FName MessageLogName;
+
+	UFUNCTION(BlueprintCallable, Category = "UHL|HotPathLint")
+	static TArray<FUHLHotPathLintFinding> LintBlueprint(UBlueprint* Blueprint);
+
+	// Loads all blueprints under path, prefer commandlet for big projects
+	UFUNCTION(BlueprintCallable, Category = "UHL|HotPathLint")
+	static TArray<FUHLHotPathLintFinding> LintBlueprintsInPath(const FString& Path = TEXT("/Game"));
+
+	static void GetBlueprintAssets(const FString& Path, TArray<FAssetData>& OutAssets);
+	// Runs lint over "/Game" and shows results in message log
+	static void LintProjectAndShowMessageLog();
+
+private:
+	struct FCostRule
+	{
+		FString EstimatedCost;
+		FString Suggestion;
+		// if set, function is only expensive when this bool pin is true or connected
+		FName ConditionPinName;
+	};
+
+	static const TMap<FName, FCostRule>& GetCostRules();
+	static bool IsUHLFunction(const UFunction* Function);
+	static bool IsBoolPinEnabled(const UEdGraphNode* Node, FName PinName);
+
+	static void GatherEntryPoints(UBlueprint* Blueprint, TArray<TPair<UEdGraphNode*, FString>>& OutEntryPoints);
+	static UEdGraphNode* FindFunctionEntry(UBlueprint* Blueprint, FName FunctionName);
+	static void LintFromEntryPoint(UBlueprint* Blueprint, UEdGraphNode* EntryNode, const FString& EntryPointName, TArray<FUHLHotPathLintFinding>& OutFindings);
+	static void LintCall(UBlueprint* Blueprint, const UK2Node_CallFunction* CallNode, const FString& EntryPointName, TArray<FUHLHotPathLintFinding>& OutFindings);
+};
@@ -56,6 +56,12 @@ public class UHLEditor : ModuleRules
 				
 				"GameplayTags",
 				"GameplayTagsEditor", 
+
+				"AssetRegistry",
+				"ContentBrowser",
+				"ContentBrowserData",
+				"BlueprintGraph",
+				"MessageLog",
 				// ... add private dependencies that you statically link with here ...
 			}
 			);
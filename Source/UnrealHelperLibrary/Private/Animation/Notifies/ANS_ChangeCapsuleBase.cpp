@@ -4,6 +4,33 @@
 
 #include "Components/CapsuleComponent.h"
 #include "DrawDebugHelpers.h"
+#include "UObject/ObjectSaveContext.h"
+
+#if WITH_EDITOR
+void UANS_ChangeCapsuleBase::PostLoad()
+{
+    Super::PostLoad();
+    BakeEaseCurve();
+}
+
+void UANS_ChangeCapsuleBase::PreSave(FObjectPreSaveContext SaveContext)
+{
+    // also happens on cook, only baked samples get to cooked data
+    BakeEaseCurve();
+    Super::PreSave(SaveContext);
+}
+
+void UANS_ChangeCapsuleBase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    BakeEaseCurve();
+}
+
+void UANS_ChangeCapsuleBase::BakeEaseCurve()
+{
+    BakedEaseCurve.Bake(EaseCurve.GetRichCurveConst());
+}
+#endif
 
 void UANS_ChangeCapsuleBase::NotifyBegin(
     USkeletalMeshComponent* MeshComp,
@@ -45,6 +72,8 @@ void UANS_ChangeCapsuleBase::NotifyBegin(
     TargetShapeColor    = bModifyShapeColor   ? NewShapeColor    : OriginalShapeColor;
 
     bHasValidOriginals = true;
+    const bool bApplyCosmetics = IsMeshSignificant(MeshComp);
+    ApplyCosmeticsByMesh.Add(MeshComp, bApplyCosmetics);
 
     // --- Construct FAlphaBlend for blend-in using FAlphaBlendArgs ---
     {
@@ -77,11 +106,11 @@ void UANS_ChangeCapsuleBase::NotifyBegin(
         {
             CapsuleComp->SetRelativeScale3D(TargetScale);
         }
-        if (bModifyLineThickness)
+        if (bModifyLineThickness && bApplyCosmetics)
         {
             CapsuleComp->SetLineThickness(TargetLineThickness);
         }
-        if (bModifyShapeColor)
+        if (bModifyShapeColor && bApplyCosmetics)
         {
             CapsuleComp->ShapeColor = TargetShapeColor.ToFColor(/*bSRGB=*/ true);
         }
@@ -106,6 +135,8 @@ void UANS_ChangeCapsuleBase::NotifyTick(
         return;
     }
 
+    const bool bApplyCosmetics = ShouldApplyCosmetics(MeshComp);
+
     ElapsedTime += FrameDeltaTime;
 
     // 1) Compute “raw alpha” in [0..1] based on blend-in / hold / blend-out
@@ -134,9 +165,9 @@ void UANS_ChangeCapsuleBase::NotifyTick(
     RawAlpha = FMath::Clamp(RawAlpha, 0.0f, 1.0f);
 
     // 2) If user provided an EaseCurve, remap RawAlpha
-    if (EaseCurve.GetRichCurveConst() && EaseCurve.GetRichCurveConst()->GetNumKeys() > 0)
+    if (!BakedEaseCurve.IsEmpty())
     {
-        float Curved = EaseCurve.GetRichCurveConst()->Eval(RawAlpha);
+        float Curved = BakedEaseCurve.Eval(RawAlpha);
         RawAlpha = FMath::Clamp(Curved, 0.0f, 1.0f);
     }
 
@@ -162,19 +193,20 @@ void UANS_ChangeCapsuleBase::NotifyTick(
         CurrentScale = FMath::Lerp(OriginalScale, TargetScale, RawAlpha);
         CapsuleComp->SetRelativeScale3D(CurrentScale);
     }
-    if (bModifyLineThickness)
+    if (bModifyLineThickness && bApplyCosmetics)
     {
         CurrentLineThickness = FMath::Lerp(OriginalLineThickness, TargetLineThickness, RawAlpha);
         CapsuleComp->SetLineThickness(CurrentLineThickness);
     }
-    if (bModifyShapeColor)
+    if (bModifyShapeColor && bApplyCosmetics)
     {
         CurrentShapeColor = FMath::Lerp(OriginalShapeColor, TargetShapeColor, RawAlpha);
         CapsuleComp->ShapeColor = CurrentShapeColor.ToFColor(/*bSRGB=*/ true);
     }
 
+#if ENABLE_DRAW_DEBUG
     // 4) If bDebug is true, draw a wireframe debug capsule using the current interpolated values
-    if (bDebug && CapsuleComp)
+    if (bDebug && bApplyCosmetics && CapsuleComp)
     {
         FVector Location = CapsuleComp->GetComponentLocation();
         FRotator Rotation = CapsuleComp->GetComponentRotation();
@@ -199,6 +231,7 @@ void UANS_ChangeCapsuleBase::NotifyTick(
             Thickness
         );
     }
+#endif
 }
 
 void UANS_ChangeCapsuleBase::NotifyEnd(
@@ -209,6 +242,9 @@ void UANS_ChangeCapsuleBase::NotifyEnd(
 {
     Super::NotifyEnd(MeshComp, Animation, EventReference);
 
+    const bool bApplyCosmetics = ShouldApplyCosmetics(MeshComp);
+    ApplyCosmeticsByMesh.Remove(MeshComp);
+
     if (!bHasValidOriginals || !CapsuleComp)
     {
         return;
@@ -227,11 +263,11 @@ void UANS_ChangeCapsuleBase::NotifyEnd(
     {
         CapsuleComp->SetRelativeScale3D(OriginalScale);
     }
-    if (bModifyLineThickness)
+    if (bModifyLineThickness && bApplyCosmetics)
     {
         CapsuleComp->SetLineThickness(OriginalLineThickness);
     }
-    if (bModifyShapeColor)
+    if (bModifyShapeColor && bApplyCosmetics)
     {
         CapsuleComp->ShapeColor = OriginalShapeColor.ToFColor(/*bSRGB=*/ true);
     }
@@ -245,6 +281,12 @@ void UANS_ChangeCapsuleBase::NotifyEnd(
     NotifyTotalDuration = 0.0f;
 }
 
+bool UANS_ChangeCapsuleBase::ShouldApplyCosmetics(const USkeletalMeshComponent* MeshComp) const
+{
+    const bool* bApplyCosmetics = ApplyCosmeticsByMesh.Find(MeshComp);
+    return bApplyCosmetics && *bApplyCosmetics;
+}
+
 void UANS_ChangeCapsuleBase::SaveOriginalCollisionSettings()
 {
 	if (!CapsuleComp) return;
@@ -8,6 +8,7 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(ANS_ChangeRotationRate)
 
+#if WITH_EDITOR
 FString UANS_ChangeRotationRate::GetNotifyName_Implementation() const
 {
 	return FString::Printf(
@@ -17,15 +18,13 @@ FString UANS_ChangeRotationRate::GetNotifyName_Implementation() const
 		RotationRate.Roll
 	);
 }
+#endif
 
 void UANS_ChangeRotationRate::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference)
 {
 	Super::NotifyBegin(MeshComp, Animation, TotalDuration, EventReference);
 
-	ACharacter* Character = Cast<ACharacter>(MeshComp->GetOwner());
-	if (!Character) return;
-
-	CharacterMovementComponent = Character->GetCharacterMovement();
+	CharacterMovementComponent = GetOwnerCharacterMovement(MeshComp);
 	if (!CharacterMovementComponent.IsValid()) return;
 
 	// UUHLCharacterMovementComponent* UHLCMC = GetUHLCharacterMovementComponent(Character);
@@ -9,7 +9,8 @@
 #include "Components/CapsuleComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Utils/UHLTraceUtilsBPL.h"
-#include "Utils/UnrealHelperLibraryBPL.h"
+#include "Utils/UHLLog.h"
+#include "Subsystems/GroundHeight/UHLGroundHeightSubsystem.h"
 #include "DrawDebugHelpers.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(ANS_EnableRootMotionZAxisMovement)
@@ -61,6 +62,20 @@ void UANS_EnableRootMotionZAxisMovement::NotifyEndOrBlendOut(USkeletalMeshCompon
 		FVector CurrentLocation = BaseCharacter->GetActorLocation();
 		FVector EndLocation = CurrentLocation + FVector(0.0f, 0.0f, -LandCheckDistance);
 
+		UUHLGroundHeightSubsystem* GroundHeightSubsystem = BaseCharacter->GetWorld()->GetSubsystem<UUHLGroundHeightSubsystem>();
+		if (bUseGroundHeightCache && !bDebug && GroundHeightSubsystem && GroundHeightSubsystem->CanAnswerTrace(CollisionChannel))
+		{
+			const float CapsuleBottomZ = CurrentLocation.Z - BaseCharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+			float GroundHeight = 0.0f;
+			const bool bHasGround = GroundHeightSubsystem->GetGroundHeight(CurrentLocation, GroundHeight, nullptr, BaseCharacter)
+				&& GroundHeight >= CapsuleBottomZ - LandCheckDistance;
+			if (!bHasGround)
+			{
+				StopRootMotionMontageOnFailedLandCheck(BaseCharacter);
+			}
+			return;
+		}
+
 		FCollisionQueryParams CollisionParams;
 		CollisionParams.AddIgnoredActor(BaseCharacter);
 		// ignore all attached actors
@@ -89,23 +104,9 @@ void UANS_EnableRootMotionZAxisMovement::NotifyEndOrBlendOut(USkeletalMeshCompon
 
 		if (!bHasHit)
 		{
-			// TODO try stop specific montage
-			// const UAnimMontage* AnimMontage = CurrentAnimMontage.Get();
-			// BaseCharacter->StopAnimMontage();
-			FAnimMontageInstance* AnimMontage = BaseCharacter->GetRootMotionAnimMontageInstance();
-			if (AnimMontage && AnimMontage->IsValid())
-			{
-				AnimMontage->PushDisableRootMotion();
-				AnimMontage->Stop(LandCheckBlendOutSettings, false);
-			}
-			else
-			{
-				UUnrealHelperLibraryBPL::DebugPrintString(
-					BaseCharacter->GetWorld(),
-					FString::Printf(TEXT("UANS_EnableRootMotionZAxisMovement::NotifyEndOrBlendOut on %s error root motion AnimMontage not found"), *BaseCharacter->GetName())
-				);
-			}
+			StopRootMotionMontageOnFailedLandCheck(BaseCharacter);
 		}
+#if ENABLE_DRAW_DEBUG
 		else
 		{
 			if (HitResult.IsValidBlockingHit() && bDebug)
@@ -117,5 +118,23 @@ void UANS_EnableRootMotionZAxisMovement::NotifyEndOrBlendOut(USkeletalMeshCompon
             	);
 			}
 		}
+#endif
+	}
+}
+
+void UANS_EnableRootMotionZAxisMovement::StopRootMotionMontageOnFailedLandCheck(ACharacter* BaseCharacter) const
+{
+	// TODO try stop specific montage
+	// const UAnimMontage* AnimMontage = CurrentAnimMontage.Get();
+	// BaseCharacter->StopAnimMontage();
+	FAnimMontageInstance* AnimMontage = BaseCharacter->GetRootMotionAnimMontageInstance();
+	if (AnimMontage && AnimMontage->IsValid())
+	{
+		AnimMontage->PushDisableRootMotion();
+		AnimMontage->Stop(LandCheckBlendOutSettings, false);
+	}
+	else
+	{
+		UHL_LOG_RATE_LIMITED(Warning, TEXT("UANS_EnableRootMotionZAxisMovement::NotifyEndOrBlendOut root motion AnimMontage not found Character=%s"), *BaseCharacter->GetName());
 	}
 }
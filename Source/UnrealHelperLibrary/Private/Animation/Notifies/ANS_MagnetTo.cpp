@@ -9,12 +9,18 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(ANS_MagnetTo)
 
+UANS_MagnetTo::UANS_MagnetTo()
+{
+    // wasn't subscribed to blend out before it became UHL notify state
+    bUseOnMontageBlendingOut = false;
+}
+
 void UANS_MagnetTo::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference)
 {
     Super::NotifyBegin(MeshComp, Animation, TotalDuration, EventReference);
 
     // Speed = Distance / TotalDuration / 60;
-    BaseCharacter = Cast<ACharacter>(MeshComp->GetOwner());
+    BaseCharacter = GetOwnerCharacter(MeshComp);
 
     // FTimerHandle TimerHandle;
     // MeshComp->GetWorld()->GetTimerManager().SetTimer(TimerHandle, this, &UANS_MagnetTo::TimerTick, 0.0f, true, -1);
@@ -7,6 +7,7 @@
 #include "GameFramework/CharacterMovementComponent.h"
 
 
+#if WITH_EDITOR
 FString UANS_UHL_AllowCharacterRotation::GetNotifyName_Implementation() const
 {
     // Base name
@@ -25,15 +26,13 @@ FString UANS_UHL_AllowCharacterRotation::GetNotifyName_Implementation() const
 
     return NotifyName;
 }
+#endif
 
 void UANS_UHL_AllowCharacterRotation::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference)
 {
 	Super::NotifyBegin(MeshComp, Animation, TotalDuration, EventReference);
 
-	ACharacter* Character = Cast<ACharacter>(MeshComp->GetOwner());
-	if (!Character) return;
-
-	CharacterMovementComponent = Character->GetCharacterMovement();
+	CharacterMovementComponent = GetOwnerCharacterMovement(MeshComp);
 	if (!CharacterMovementComponent.IsValid()) return;
 
     CharacterMovementComponent->bAllowPhysicsRotationDuringAnimRootMotion = true;
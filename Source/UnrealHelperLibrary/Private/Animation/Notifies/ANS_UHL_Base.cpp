@@ -5,6 +5,9 @@
 #include "Runtime/Engine/Classes/Animation/AnimMontage.h"
 #include "Engine/World.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Animation/UHLMontageTimelineExecutorComponent.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(ANS_UHL_Base)
 
@@ -38,6 +41,29 @@ void UANS_UHL_Base::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBas
 	}
 }
 
+/** Montage timeline execution **/
+ACharacter* UANS_UHL_Base::GetOwnerCharacter(const USkeletalMeshComponent* MeshComp) const
+{
+	const FUHLMontageTimelineContext* Context = UUHLMontageTimelineExecutorComponent::GetDispatchingContext();
+	if (Context && Context->Mesh == MeshComp)
+	{
+		return Context->Character.Get();
+	}
+	return MeshComp ? Cast<ACharacter>(MeshComp->GetOwner()) : nullptr;
+}
+
+UCharacterMovementComponent* UANS_UHL_Base::GetOwnerCharacterMovement(const USkeletalMeshComponent* MeshComp) const
+{
+	const FUHLMontageTimelineContext* Context = UUHLMontageTimelineExecutorComponent::GetDispatchingContext();
+	if (Context && Context->Mesh == MeshComp)
+	{
+		return Context->CharacterMovement.Get();
+	}
+	const ACharacter* Character = MeshComp ? Cast<ACharacter>(MeshComp->GetOwner()) : nullptr;
+	return Character ? Character->GetCharacterMovement() : nullptr;
+}
+/** ~Montage timeline execution **/
+
 /** Experimental **/ 
 void UANS_UHL_Base::NotifyEndOrBlendOut(USkeletalMeshComponent* MeshComp)
 {
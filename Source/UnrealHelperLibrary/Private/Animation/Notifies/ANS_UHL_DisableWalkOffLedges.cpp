@@ -11,10 +11,10 @@ void UANS_UHL_DisableWalkOffLedges::NotifyBegin(USkeletalMeshComponent* MeshComp
 {
     if (!MeshComp) return;
 
-    ACharacter* OwnerChar = Cast<ACharacter>(MeshComp->GetOwner());
+    ACharacter* OwnerChar = GetOwnerCharacter(MeshComp);
     if (!OwnerChar) return;
 
-    UCharacterMovementComponent* MoveComp = OwnerChar->GetCharacterMovement();
+    UCharacterMovementComponent* MoveComp = GetOwnerCharacterMovement(MeshComp);
     if (!MoveComp) return;
 
     // Store original
@@ -37,10 +37,7 @@ void UANS_UHL_DisableWalkOffLedges::NotifyEnd(USkeletalMeshComponent* MeshComp,
 {
     if (!MeshComp) return;
 
-    ACharacter* OwnerChar = Cast<ACharacter>(MeshComp->GetOwner());
-    if (!OwnerChar) return;
-
-    UCharacterMovementComponent* MoveComp = OwnerChar->GetCharacterMovement();
+    UCharacterMovementComponent* MoveComp = GetOwnerCharacterMovement(MeshComp);
     if (!MoveComp) return;
 
     // Restore original if we stored them
@@ -4,6 +4,11 @@
 #include "Animation/Notifies/AN_AttachActorWithUniqueId.h"
 #include "Evaluators/UHLAttachmentTargetEvaluator.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Components/UHLCrowdPropMergeComponent.h"
+#include "Core/UHLAttachmentPropData.h"
+#include "Subsystems/ActorTagIndex/UHLActorTagIndexSubsystem.h"
+#include "Subsystems/AttachmentPropPool/UHLAttachmentPropPoolSubsystem.h"
+#include "Utils/UHLLog.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AN_AttachActorWithUniqueId)
 
@@ -24,10 +29,12 @@ void UAN_AttachActorWithUniqueId::PostEditChangeProperty(
 }
 #endif
 
+#if WITH_EDITOR
 FString UAN_AttachActorWithUniqueId::GetNotifyName_Implementation() const
 {
 	return FString("Attach With UniqueId -> ") + UniqueId.ToString();
 }
+#endif
 
 void UAN_AttachActorWithUniqueId::Notify(
 	USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
@@ -40,11 +47,25 @@ void UAN_AttachActorWithUniqueId::Notify(
 	AActor* OwnerActor = MeshComp->GetOwner();
 	if (!OwnerActor) return;
 
+	if (bCosmeticOnly && !IsMeshSignificant(MeshComp)) return;
+
+	// merged props must be visible again before attachments change
+	if (UUHLCrowdPropMergeComponent* PropMergeComponent = OwnerActor->FindComponentByClass<UUHLCrowdPropMergeComponent>())
+	{
+		PropMergeComponent->RestoreProps();
+	}
+
+	if (bAttachComponentOnly)
+	{
+		AttachComponentOnly(MeshComp, OwnerActor);
+		return;
+	}
+
 	// 1) Load the class synchronously
 	UClass* ActorClass = ActorToAttach.LoadSynchronous();
 	if (!ActorClass)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Failed to load ActorToSpawn!"));
+		UHL_LOG_RATE_LIMITED(Warning, TEXT("AN_AttachActorWithUniqueId: failed to load ActorToSpawn Notify=%s Owner=%s"), *GetNameSafe(this), *GetNameSafe(OwnerActor));
 		return;
 	}
 
@@ -76,5 +97,35 @@ void UAN_AttachActorWithUniqueId::Notify(
 	if (!SpawnedActor) return;
 
 	SpawnedActor->AttachToComponent(AttachmentComp, AttachmentRules.ToEngineRules(), SocketName);
-	SpawnedActor->Tags.Add(UniqueId);
-}
\ No newline at end of file
+	// tag added after spawn, index has to know about it for AN_DetachActorWithUniqueId lookup
+	if (UUHLActorTagIndexSubsystem* TagIndexSubsystem = UWorld::GetSubsystem<UUHLActorTagIndexSubsystem>(SpawnedActor->GetWorld()))
+	{
+		TagIndexSubsystem->AddActorTag(SpawnedActor, UniqueId);
+	}
+	else
+	{
+		SpawnedActor->Tags.Add(UniqueId);
+	}
+}
+
+void UAN_AttachActorWithUniqueId::AttachComponentOnly(USkeletalMeshComponent* MeshComp, AActor* OwnerActor) const
+{
+	UUHLAttachmentPropPoolSubsystem* PropPool = MeshComp->GetWorld()->GetSubsystem<UUHLAttachmentPropPoolSubsystem>();
+	const UUHLAttachmentPropData* LoadedPropData = PropData.LoadSynchronous();
+	if (!PropPool || !LoadedPropData)
+	{
+		UHL_LOG_RATE_LIMITED(Warning, TEXT("AN_AttachActorWithUniqueId: failed to load PropData Notify=%s Owner=%s"), *GetNameSafe(this), *GetNameSafe(OwnerActor));
+		return;
+	}
+
+	USceneComponent* AttachmentComp = MeshComp;
+	if (bUseChildActorForAttachment && IsValid(ChildActorTarget))
+	{
+		UUHLAttachmentTargetEvaluator* Evaluator = NewObject<UUHLAttachmentTargetEvaluator>(OwnerActor, ChildActorTarget);
+		AttachmentComp = Evaluator->GetMeshComponent(OwnerActor);
+	}
+	if (!IsValid(AttachmentComp)) return;
+
+	// prop's RelativeTransform applied after attachment, so only location rule matters
+	PropPool->AttachProp(OwnerActor, LoadedPropData, AttachmentComp, SocketName, UniqueId, AttachmentRules.LocationRule);
+}
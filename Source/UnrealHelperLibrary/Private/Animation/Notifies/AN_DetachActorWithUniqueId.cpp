@@ -5,9 +5,12 @@
 
 #include "Components/SkeletalMeshComponent.h"
 #include "Components/PrimitiveComponent.h"
+#include "Components/MeshComponent.h"
 #include "Components/ActorComponent.h"
 #include "TimerManager.h"
 #include "Utils/UnrealHelperLibraryBPL.h"
+#include "Components/UHLCrowdPropMergeComponent.h"
+#include "Subsystems/AttachmentPropPool/UHLAttachmentPropPoolSubsystem.h"
 
 #if WITH_EDITOR
 void UAN_DetachActorWithUniqueId::PostEditChangeProperty(
@@ -26,10 +29,12 @@ void UAN_DetachActorWithUniqueId::PostEditChangeProperty(
 }
 #endif
 
+#if WITH_EDITOR
 FString UAN_DetachActorWithUniqueId::GetNotifyName_Implementation() const
 {
 	return FString("Detach With UniqueId->") + UniqueId.ToString();
 }
+#endif
 
 void UAN_DetachActorWithUniqueId::Notify(
 	USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
@@ -42,8 +47,18 @@ void UAN_DetachActorWithUniqueId::Notify(
 	AActor* OwnerActor = MeshComp->GetOwner();
 	if (!OwnerActor) return;
 
+	if (UUHLCrowdPropMergeComponent* PropMergeComponent = OwnerActor->FindComponentByClass<UUHLCrowdPropMergeComponent>())
+	{
+		PropMergeComponent->RestoreProps();
+	}
+
 	AActor* AttachedActor = UUnrealHelperLibraryBPL::FindAttachedActorByTag(OwnerActor, UniqueId);
-	if (!AttachedActor) return;
+	if (!AttachedActor)
+	{
+		// attached by AN_AttachActorWithUniqueId with "bAttachComponentOnly"
+		DetachProp(MeshComp, OwnerActor);
+		return;
+	}
 
 	AttachedActor->DetachFromActor(DetachmentRules.ToEngineRules());
 	
@@ -85,4 +100,38 @@ void UAN_DetachActorWithUniqueId::Notify(
 	{
 		AttachedActor->SetLifeSpan(AutoDestroyDelay);
 	}
-}
\ No newline at end of file
+}
+
+void UAN_DetachActorWithUniqueId::DetachProp(USkeletalMeshComponent* MeshComp, AActor* OwnerActor)
+{
+	UUHLAttachmentPropPoolSubsystem* PropPool = MeshComp->GetWorld()->GetSubsystem<UUHLAttachmentPropPoolSubsystem>();
+	if (!PropPool) return;
+
+	UMeshComponent* PropComponent = PropPool->DetachProp(OwnerActor, UniqueId, DetachmentRules.DetachmentRule);
+	if (!PropComponent) return;
+
+	if (bEnablePhysicsOnDetach && EnablePhysicsDelay < AutoDestroyDelay)
+	{
+		TWeakObjectPtr<UMeshComponent> WeakPropComponent = PropComponent;
+		FTimerDelegate Delegate;
+		Delegate.BindLambda([WeakPropComponent]()
+		{
+			if (UMeshComponent* Prim = WeakPropComponent.Get())
+			{
+				Prim->SetCollisionProfileName(TEXT("PhysicsActor"));
+				Prim->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+				Prim->SetSimulatePhysics(true);
+				const FVector Impulse = Prim->GetForwardVector() * 200.0f
+									 + FVector::UpVector * 100.0f;
+				Prim->AddImpulse(Impulse, NAME_None, /*bVelChange=*/ true);
+			}
+		});
+		MeshComp->GetWorld()->GetTimerManager().SetTimer(TimerHandle, Delegate, EnablePhysicsDelay, false);
+	}
+
+	// returns to pool instead of destroying, cancelled if same UniqueId attached again before
+	if (bAutoDestroy)
+	{
+		PropPool->ReleasePropDelayed(OwnerActor, UniqueId, AutoDestroyDelay);
+	}
+}
@@ -0,0 +1,18 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Animation/UHLAnimInstance.h"
+
+#include "Animation/UHLMontageTimelineExecutorComponent.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLAnimInstance)
+
+bool UUHLAnimInstance::ShouldTriggerAnimNotifyState(const UAnimNotifyState* AnimNotifyState) const
+{
+	const UUHLMontageTimelineExecutorComponent* Executor = TimelineExecutor.Get();
+	if (Executor && Executor->ClaimsNotifyState(AnimNotifyState))
+	{
+		return false;
+	}
+	return Super::ShouldTriggerAnimNotifyState(AnimNotifyState);
+}
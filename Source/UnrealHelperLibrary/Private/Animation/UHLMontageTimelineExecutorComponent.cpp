@@ -0,0 +1,294 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Animation/UHLMontageTimelineExecutorComponent.h"
+
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/Notifies/ANS_UHL_Base.h"
+#include "Animation/UHLAnimInstance.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "UnrealHelperLibrary.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLMontageTimelineExecutorComponent)
+
+const FUHLMontageTimelineContext* UUHLMontageTimelineExecutorComponent::DispatchingContext = nullptr;
+
+UUHLMontageTimelineExecutorComponent::UUHLMontageTimelineExecutorComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UUHLMontageTimelineExecutorComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	ACharacter* Character = Cast<ACharacter>(GetOwner());
+	USkeletalMeshComponent* Mesh = Character ? Character->GetMesh() : GetOwner()->FindComponentByClass<USkeletalMeshComponent>();
+	UUHLAnimInstance* AnimInstance = Mesh ? Cast<UUHLAnimInstance>(Mesh->GetAnimInstance()) : nullptr;
+	if (!AnimInstance)
+	{
+		// without filtering claimed notify states would run twice, by engine and by timeline
+		UE_LOG(LogUnrealHelperLibrary, Warning, TEXT("UHLMontageTimelineExecutorComponent on %s inactive, mesh anim instance isn't UHLAnimInstance"), *GetNameSafe(GetOwner()));
+		return;
+	}
+
+	Context.Mesh = Mesh;
+	Context.AnimInstance = AnimInstance;
+	Context.Character = Character;
+	Context.CharacterMovement = Character ? Character->GetCharacterMovement() : nullptr;
+
+	// run timeline after animation updated montage positions
+	PrimaryComponentTick.AddPrerequisite(Mesh, Mesh->PrimaryComponentTick);
+
+	AnimInstance->OnMontageStarted.AddDynamic(this, &UUHLMontageTimelineExecutorComponent::OnMontageStarted);
+	AnimInstance->OnMontageEnded.AddDynamic(this, &UUHLMontageTimelineExecutorComponent::OnMontageEnded);
+	AnimInstance->SetTimelineExecutor(this);
+}
+
+void UUHLMontageTimelineExecutorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (FRunningMontage& RunningMontage : RunningMontages)
+	{
+		EndRunningMontage(RunningMontage);
+	}
+	RunningMontages.Empty();
+
+	if (UAnimInstance* AnimInstance = Context.AnimInstance.Get())
+	{
+		AnimInstance->OnMontageStarted.RemoveDynamic(this, &UUHLMontageTimelineExecutorComponent::OnMontageStarted);
+		AnimInstance->OnMontageEnded.RemoveDynamic(this, &UUHLMontageTimelineExecutorComponent::OnMontageEnded);
+		if (UUHLAnimInstance* UHLAnimInstance = Cast<UUHLAnimInstance>(AnimInstance))
+		{
+			UHLAnimInstance->SetTimelineExecutor(nullptr);
+		}
+	}
+	CompiledTimelines.Empty();
+	ClaimedNotifyStates.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UUHLMontageTimelineExecutorComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	UAnimInstance* AnimInstance = Context.AnimInstance.Get();
+	for (int32 i = RunningMontages.Num() - 1; i >= 0; i--)
+	{
+		FRunningMontage& RunningMontage = RunningMontages[i];
+		const TArray<FCompiledNotifyState>* Timeline = CompiledTimelines.Find(RunningMontage.Montage.Get());
+		const FAnimMontageInstance* MontageInstance = AnimInstance && RunningMontage.Montage.IsValid()
+			? AnimInstance->GetActiveInstanceForMontage(RunningMontage.Montage.Get())
+			: nullptr;
+
+		if (!Timeline || !MontageInstance)
+		{
+			EndRunningMontage(RunningMontage);
+			RunningMontages.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		TickRunningMontage(RunningMontage, *Timeline, MontageInstance->GetPosition(), DeltaTime);
+	}
+
+	if (RunningMontages.IsEmpty())
+	{
+		SetComponentTickEnabled(false);
+	}
+}
+
+void UUHLMontageTimelineExecutorComponent::CompileTimeline(UAnimMontage* Montage)
+{
+	TArray<FCompiledNotifyState>& Timeline = CompiledTimelines.Add(Montage);
+	for (int32 i = 0; i < Montage->Notifies.Num(); i++)
+	{
+		const FAnimNotifyEvent& NotifyEvent = Montage->Notifies[i];
+		const UANS_UHL_Base* NotifyState = Cast<UANS_UHL_Base>(NotifyEvent.NotifyStateClass);
+		if (!NotifyState || !NotifyState->SupportsTimelineExecution())
+		{
+			continue;
+		}
+
+		FCompiledNotifyState& CompiledNotifyState = Timeline.AddDefaulted_GetRef();
+		CompiledNotifyState.Montage = Montage;
+		CompiledNotifyState.NotifyIndex = i;
+		CompiledNotifyState.NotifyState = NotifyState;
+		ClaimedNotifyStates.Add(NotifyState);
+		CompiledNotifyState.StartTime = NotifyEvent.GetTriggerTime();
+		CompiledNotifyState.EndTime = NotifyEvent.GetEndTriggerTime();
+	}
+
+	Timeline.Sort([](const FCompiledNotifyState& A, const FCompiledNotifyState& B) { return A.StartTime < B.StartTime; });
+}
+
+void UUHLMontageTimelineExecutorComponent::TickRunningMontage(FRunningMontage& RunningMontage, const TArray<FCompiledNotifyState>& Timeline, float Position, float DeltaTime)
+{
+	UAnimMontage* Montage = RunningMontage.Montage.Get();
+	const float PreviousPosition = RunningMontage.PreviousPosition;
+
+	for (int32 i = 0; i < Timeline.Num(); i++)
+	{
+		const FCompiledNotifyState& CompiledNotifyState = Timeline[i];
+		const bool bInRange = Position >= CompiledNotifyState.StartTime && Position < CompiledNotifyState.EndTime;
+		const bool bActive = RunningMontage.ActiveNotifyStates[i];
+
+		if (bActive && bInRange)
+		{
+			DispatchTick(CompiledNotifyState, Montage, DeltaTime);
+		}
+		else if (bActive)
+		{
+			DispatchEnd(CompiledNotifyState, Montage);
+			RunningMontage.ActiveNotifyStates[i] = false;
+		}
+		else if (bInRange)
+		{
+			DispatchBegin(CompiledNotifyState, Montage);
+			RunningMontage.ActiveNotifyStates[i] = true;
+		}
+		// whole notify state passed between two ticks
+		else if (Position > PreviousPosition
+			&& CompiledNotifyState.StartTime >= PreviousPosition
+			&& CompiledNotifyState.EndTime <= Position)
+		{
+			DispatchBegin(CompiledNotifyState, Montage);
+			DispatchEnd(CompiledNotifyState, Montage);
+		}
+	}
+
+	RunningMontage.PreviousPosition = Position;
+}
+
+void UUHLMontageTimelineExecutorComponent::EndRunningMontage(FRunningMontage& RunningMontage)
+{
+	const TArray<FCompiledNotifyState>* Timeline = CompiledTimelines.Find(RunningMontage.Montage.Get());
+	if (!Timeline)
+	{
+		return;
+	}
+
+	for (TConstSetBitIterator<> It(RunningMontage.ActiveNotifyStates); It; ++It)
+	{
+		DispatchEnd((*Timeline)[It.GetIndex()], RunningMontage.Montage.Get());
+	}
+	RunningMontage.ActiveNotifyStates.Init(false, Timeline->Num());
+}
+
+const FAnimNotifyEvent* UUHLMontageTimelineExecutorComponent::GetNotifyEvent(const FCompiledNotifyState& CompiledNotifyState)
+{
+	const UAnimMontage* Montage = CompiledNotifyState.Montage.Get();
+	if (!Montage || !Montage->Notifies.IsValidIndex(CompiledNotifyState.NotifyIndex))
+	{
+		return nullptr;
+	}
+	// notifies changed since timeline compiled
+	const FAnimNotifyEvent& NotifyEvent = Montage->Notifies[CompiledNotifyState.NotifyIndex];
+	return NotifyEvent.NotifyStateClass == CompiledNotifyState.NotifyState ? &NotifyEvent : nullptr;
+}
+
+void UUHLMontageTimelineExecutorComponent::DispatchBegin(const FCompiledNotifyState& CompiledNotifyState, UAnimMontage* Montage)
+{
+	const FAnimNotifyEvent* NotifyEvent = GetNotifyEvent(CompiledNotifyState);
+	if (!NotifyEvent)
+	{
+		return;
+	}
+
+	TGuardValue<const FUHLMontageTimelineContext*> DispatchingContextGuard(DispatchingContext, &Context);
+	const FAnimNotifyEventReference EventReference(NotifyEvent, Montage);
+	NotifyEvent->NotifyStateClass->NotifyBegin(Context.Mesh.Get(), Montage, NotifyEvent->GetDuration(), EventReference);
+}
+
+void UUHLMontageTimelineExecutorComponent::DispatchTick(const FCompiledNotifyState& CompiledNotifyState, UAnimMontage* Montage, float DeltaTime)
+{
+	const FAnimNotifyEvent* NotifyEvent = GetNotifyEvent(CompiledNotifyState);
+	if (!NotifyEvent)
+	{
+		return;
+	}
+
+	TGuardValue<const FUHLMontageTimelineContext*> DispatchingContextGuard(DispatchingContext, &Context);
+	const FAnimNotifyEventReference EventReference(NotifyEvent, Montage);
+	NotifyEvent->NotifyStateClass->NotifyTick(Context.Mesh.Get(), Montage, DeltaTime, EventReference);
+}
+
+void UUHLMontageTimelineExecutorComponent::DispatchEnd(const FCompiledNotifyState& CompiledNotifyState, UAnimMontage* Montage)
+{
+	const FAnimNotifyEvent* NotifyEvent = GetNotifyEvent(CompiledNotifyState);
+	if (!NotifyEvent)
+	{
+		return;
+	}
+
+	TGuardValue<const FUHLMontageTimelineContext*> DispatchingContextGuard(DispatchingContext, &Context);
+	const FAnimNotifyEventReference EventReference(NotifyEvent, Montage);
+	NotifyEvent->NotifyStateClass->NotifyEnd(Context.Mesh.Get(), Montage, EventReference);
+}
+
+void UUHLMontageTimelineExecutorComponent::OnMontageStarted(UAnimMontage* Montage)
+{
+	if (!Montage || !Context.Mesh.IsValid())
+	{
+		return;
+	}
+
+	// montage notifies can be edited while playing in editor
+#if WITH_EDITOR
+	if (const TArray<FCompiledNotifyState>* PreviousTimeline = CompiledTimelines.Find(Montage))
+	{
+		for (const FCompiledNotifyState& CompiledNotifyState : *PreviousTimeline)
+		{
+			ClaimedNotifyStates.Remove(CompiledNotifyState.NotifyState);
+		}
+		CompiledTimelines.Remove(Montage);
+	}
+#endif
+	if (!CompiledTimelines.Contains(Montage))
+	{
+		CompileTimeline(Montage);
+	}
+
+	const TArray<FCompiledNotifyState>& Timeline = CompiledTimelines.FindChecked(Montage);
+	if (Timeline.IsEmpty())
+	{
+		return;
+	}
+
+	// restarted while playing - end previous run first
+	FRunningMontage* RunningMontage = RunningMontages.FindByPredicate([Montage](const FRunningMontage& Running) { return Running.Montage == Montage; });
+	if (RunningMontage)
+	{
+		EndRunningMontage(*RunningMontage);
+	}
+	else
+	{
+		RunningMontage = &RunningMontages.AddDefaulted_GetRef();
+		RunningMontage->Montage = Montage;
+	}
+	RunningMontage->ActiveNotifyStates.Init(false, Timeline.Num());
+	// notify states starting at 0 should begin on first tick
+	RunningMontage->PreviousPosition = -UE_SMALL_NUMBER;
+
+	SetComponentTickEnabled(true);
+}
+
+void UUHLMontageTimelineExecutorComponent::OnMontageEnded(UAnimMontage* Montage, bool bInterrupted)
+{
+	// ended instance could be replaced by new one of same montage
+	UAnimInstance* AnimInstance = Context.AnimInstance.Get();
+	if (AnimInstance && AnimInstance->GetActiveInstanceForMontage(Montage))
+	{
+		return;
+	}
+
+	const int32 Index = RunningMontages.IndexOfByPredicate([Montage](const FRunningMontage& Running) { return Running.Montage == Montage; });
+	if (Index != INDEX_NONE)
+	{
+		EndRunningMontage(RunningMontages[Index]);
+		RunningMontages.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+}
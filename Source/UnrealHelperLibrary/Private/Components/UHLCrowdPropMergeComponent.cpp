@@ -0,0 +1,468 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Components/UHLCrowdPropMergeComponent.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/GameInstance.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "Materials/MaterialInterface.h"
+#include "MeshDescription.h"
+#include "SkeletalMeshMerge.h"
+#include "StaticMeshAttributes.h"
+#include "StaticMeshResources.h"
+#include "Subsystems/CrowdPropMerge/UHLCrowdPropMergeCacheSubsystem.h"
+#include "TimerManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLCrowdPropMergeComponent)
+
+namespace UHLCrowdPropMerge
+{
+	FIntVector QuantizeVector(const FVector& Vector, float Scale)
+	{
+		return FIntVector(FMath::RoundToInt32(Vector.X * Scale), FMath::RoundToInt32(Vector.Y * Scale), FMath::RoundToInt32(Vector.Z * Scale));
+	}
+
+	// rounded, so same props on different enemies share merged mesh
+	FUHLMergedStaticPropDesc MakePropDesc(const UStaticMeshComponent* StaticMeshComponent, const FTransform& SocketTransform)
+	{
+		const FTransform RelativeTransform = StaticMeshComponent->GetComponentTransform().GetRelativeTransform(SocketTransform);
+
+		FUHLMergedStaticPropDesc Desc;
+		Desc.Mesh = StaticMeshComponent->GetStaticMesh();
+		for (int32 i = 0; i < StaticMeshComponent->GetNumMaterials(); i++)
+		{
+			Desc.Materials.Add(StaticMeshComponent->GetMaterial(i));
+		}
+		Desc.Location = QuantizeVector(RelativeTransform.GetLocation(), 10.0f);
+		Desc.Rotation = QuantizeVector(RelativeTransform.Rotator().Euler(), 10.0f);
+		Desc.Scale = QuantizeVector(RelativeTransform.GetScale3D(), 100.0f);
+		return Desc;
+	}
+}
+
+UUHLCrowdPropMergeComponent::UUHLCrowdPropMergeComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UUHLCrowdPropMergeComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	ACharacter* Character = Cast<ACharacter>(GetOwner());
+	OwnerMesh = Character ? Character->GetMesh() : GetOwner()->FindComponentByClass<USkeletalMeshComponent>();
+
+	bInMergeTier = !bMergeOnlyInFarTiers;
+	if (bMergeOnlyInFarTiers && Character)
+	{
+		const UGameInstance* GameInstance = GetWorld()->GetGameInstance();
+		if (UEnemyTickOptimizerSubsystem* EnemyTickOptimizer = GameInstance ? GameInstance->GetSubsystem<UEnemyTickOptimizerSubsystem>() : nullptr)
+		{
+			TierChangedHandle = EnemyTickOptimizer->AddOnTierChangedHandler(Character,
+				FOnEnemyTickOptimizerTierChanged::FDelegate::CreateUObject(this, &UUHLCrowdPropMergeComponent::OnTierChanged));
+			bInMergeTier = EnemyTickOptimizer->GetEnemyTier(Character) >= MinMergeTier;
+		}
+	}
+
+	if (bInMergeTier)
+	{
+		OnTierChanged(Character, EEnemyTickOptimizerTier::None, MinMergeTier);
+	}
+}
+
+void UUHLCrowdPropMergeComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorld()->GetTimerManager().ClearTimer(SettleCheckTimerHandle);
+
+	const UGameInstance* GameInstance = GetWorld()->GetGameInstance();
+	if (UEnemyTickOptimizerSubsystem* EnemyTickOptimizer = GameInstance ? GameInstance->GetSubsystem<UEnemyTickOptimizerSubsystem>() : nullptr)
+	{
+		EnemyTickOptimizer->RemoveOnTierChangedHandler(Cast<ACharacter>(GetOwner()), TierChangedHandle);
+	}
+
+	RestoreProps();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UUHLCrowdPropMergeComponent::OnTierChanged(ACharacter* Enemy, EEnemyTickOptimizerTier OldTier, EEnemyTickOptimizerTier NewTier)
+{
+	bInMergeTier = !bMergeOnlyInFarTiers || NewTier >= MinMergeTier;
+
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	if (!bInMergeTier)
+	{
+		TimerManager.ClearTimer(SettleCheckTimerHandle);
+		RestoreProps();
+		return;
+	}
+
+	if (!TimerManager.IsTimerActive(SettleCheckTimerHandle))
+	{
+		PropsSignature = CalculatePropsSignature();
+		PropsSignatureTime = GetWorld()->GetTimeSeconds();
+		TimerManager.SetTimer(SettleCheckTimerHandle, this, &UUHLCrowdPropMergeComponent::CheckPropsSettled, FMath::Max(SettleTime * 0.5f, 0.1f), true);
+	}
+}
+
+void UUHLCrowdPropMergeComponent::CheckPropsSettled()
+{
+	const uint32 Signature = CalculatePropsSignature();
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	if (Signature != PropsSignature)
+	{
+		RestoreProps();
+		PropsSignature = Signature;
+		PropsSignatureTime = CurrentTime;
+		return;
+	}
+
+	if (!bMerged && CurrentTime - PropsSignatureTime >= SettleTime)
+	{
+		MergeProps();
+	}
+}
+
+void UUHLCrowdPropMergeComponent::GatherProps(TArray<FStaticPropGroup>& OutStaticGroups, TArray<USkeletalMeshComponent*>& OutSkeletalProps) const
+{
+	USkeletalMeshComponent* Mesh = OwnerMesh.Get();
+	if (!Mesh || !Mesh->GetSkeletalMeshAsset())
+	{
+		return;
+	}
+
+	TArray<USceneComponent*> PropComponents;
+	for (USceneComponent* Child : Mesh->GetAttachChildren())
+	{
+		// own components (and merged ones) are not props
+		if (!Child || Child->GetOwner() == GetOwner())
+		{
+			continue;
+		}
+
+		PropComponents.Reset();
+		PropComponents.Add(Child);
+		Child->GetChildrenComponents(true, PropComponents);
+
+		for (USceneComponent* PropComponent : PropComponents)
+		{
+			const bool bHiddenByMerge = HiddenComponents.ContainsByPredicate([PropComponent](const TWeakObjectPtr<UMeshComponent>& HiddenComponent) { return HiddenComponent.Get() == PropComponent; });
+			if (!bHiddenByMerge && !PropComponent->IsVisible())
+			{
+				continue;
+			}
+
+			if (UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(PropComponent))
+			{
+				if (!StaticMeshComponent->GetStaticMesh() || StaticMeshComponent->IsSimulatingPhysics())
+				{
+					continue;
+				}
+
+				const FName SocketName = Child->GetAttachSocketName();
+				FStaticPropGroup* Group = OutStaticGroups.FindByPredicate([SocketName](const FStaticPropGroup& Existing) { return Existing.SocketName == SocketName; });
+				if (!Group)
+				{
+					Group = &OutStaticGroups.AddDefaulted_GetRef();
+					Group->SocketName = SocketName;
+				}
+				Group->Components.Add(StaticMeshComponent);
+			}
+			else if (USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(PropComponent))
+			{
+				// only props following owner pose and without material overrides can be merged
+				if (bMergeSkeletalProps
+					&& SkeletalMeshComponent->LeaderPoseComponent == Mesh
+					&& SkeletalMeshComponent->GetSkeletalMeshAsset()
+					&& SkeletalMeshComponent->GetSkeletalMeshAsset()->GetSkeleton() == Mesh->GetSkeletalMeshAsset()->GetSkeleton()
+					&& SkeletalMeshComponent->GetNumOverrideMaterials() == 0)
+				{
+					OutSkeletalProps.Add(SkeletalMeshComponent);
+				}
+			}
+		}
+	}
+}
+
+uint32 UUHLCrowdPropMergeComponent::CalculatePropsSignature() const
+{
+	uint32 Signature = 0;
+	if (const USkeletalMeshComponent* Mesh = OwnerMesh.Get())
+	{
+		for (const USceneComponent* Child : Mesh->GetAttachChildren())
+		{
+			if (Child && Child->GetOwner() != GetOwner())
+			{
+				Signature = HashCombine(Signature, HashCombine(GetTypeHash(Child), GetTypeHash(Child->GetNumChildrenComponents())));
+			}
+		}
+	}
+	return Signature;
+}
+
+void UUHLCrowdPropMergeComponent::MergeProps()
+{
+	USkeletalMeshComponent* Mesh = OwnerMesh.Get();
+	if (bMerged || !Mesh || !Mesh->GetSkeletalMeshAsset())
+	{
+		return;
+	}
+
+	TArray<FStaticPropGroup> StaticGroups;
+	TArray<USkeletalMeshComponent*> SkeletalProps;
+	GatherProps(StaticGroups, SkeletalProps);
+
+	// nothing to merge is still "merged", no need to retry until attachments change
+	bMerged = true;
+
+	for (const FStaticPropGroup& Group : StaticGroups)
+	{
+		if (Group.Components.Num() < 2)
+		{
+			continue;
+		}
+
+		UStaticMesh* MergedMesh = GetOrBuildMergedStaticMesh(Group, Mesh->GetSocketTransform(Group.SocketName));
+		if (!MergedMesh)
+		{
+			continue;
+		}
+
+		UStaticMeshComponent* MergedComponent = NewObject<UStaticMeshComponent>(GetOwner());
+		MergedComponent->SetStaticMesh(MergedMesh);
+		MergedComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		MergedComponent->SetupAttachment(Mesh, Group.SocketName);
+		MergedComponent->RegisterComponent();
+		MergedComponents.Add(MergedComponent);
+
+		for (UStaticMeshComponent* StaticMeshComponent : Group.Components)
+		{
+			StaticMeshComponent->SetVisibility(false);
+			HiddenComponents.Add(StaticMeshComponent);
+		}
+	}
+
+	if (SkeletalProps.Num() >= 2)
+	{
+		if (USkeletalMesh* MergedMesh = GetOrBuildMergedSkeletalMesh(SkeletalProps))
+		{
+			USkeletalMeshComponent* MergedComponent = NewObject<USkeletalMeshComponent>(GetOwner());
+			MergedComponent->SetSkeletalMeshAsset(MergedMesh);
+			MergedComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			MergedComponent->SetupAttachment(Mesh);
+			MergedComponent->RegisterComponent();
+			MergedComponent->SetLeaderPoseComponent(Mesh);
+			MergedComponents.Add(MergedComponent);
+
+			for (USkeletalMeshComponent* SkeletalMeshComponent : SkeletalProps)
+			{
+				SkeletalMeshComponent->SetVisibility(false);
+				HiddenComponents.Add(SkeletalMeshComponent);
+			}
+		}
+	}
+}
+
+void UUHLCrowdPropMergeComponent::RestoreProps()
+{
+	if (!bMerged)
+	{
+		return;
+	}
+
+	for (UMeshComponent* MergedComponent : MergedComponents)
+	{
+		if (IsValid(MergedComponent))
+		{
+			MergedComponent->DestroyComponent();
+		}
+	}
+	MergedComponents.Reset();
+
+	for (const TWeakObjectPtr<UMeshComponent>& HiddenComponent : HiddenComponents)
+	{
+		if (HiddenComponent.IsValid())
+		{
+			HiddenComponent->SetVisibility(true);
+		}
+	}
+	HiddenComponents.Reset();
+
+	bMerged = false;
+	PropsSignatureTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
+}
+
+UStaticMesh* UUHLCrowdPropMergeComponent::GetOrBuildMergedStaticMesh(const FStaticPropGroup& Group, const FTransform& SocketTransform) const
+{
+	UUHLCrowdPropMergeCacheSubsystem* MergeCache = UWorld::GetSubsystem<UUHLCrowdPropMergeCacheSubsystem>(GetWorld());
+
+	FUHLMergedStaticMeshKey CacheKey;
+	if (MergeCache)
+	{
+		CacheKey.LODIndex = StaticMeshLODIndex;
+		for (const UStaticMeshComponent* StaticMeshComponent : Group.Components)
+		{
+			CacheKey.Props.Add(UHLCrowdPropMerge::MakePropDesc(StaticMeshComponent, SocketTransform));
+		}
+		// order doesn't matter for result, sorted to share cache
+		CacheKey.Props.Sort();
+
+		if (UStaticMesh* CachedMesh = MergeCache->FindStaticMesh(CacheKey))
+		{
+			return CachedMesh;
+		}
+	}
+
+	FMeshDescription MeshDescription;
+	FStaticMeshAttributes Attributes(MeshDescription);
+	Attributes.Register();
+
+	TVertexAttributesRef<FVector3f> Positions = Attributes.GetVertexPositions();
+	TVertexInstanceAttributesRef<FVector3f> Normals = Attributes.GetVertexInstanceNormals();
+	TVertexInstanceAttributesRef<FVector3f> Tangents = Attributes.GetVertexInstanceTangents();
+	TVertexInstanceAttributesRef<float> BinormalSigns = Attributes.GetVertexInstanceBinormalSigns();
+	TVertexInstanceAttributesRef<FVector2f> UVs = Attributes.GetVertexInstanceUVs();
+	TPolygonGroupAttributesRef<FName> MaterialSlotNames = Attributes.GetPolygonGroupMaterialSlotNames();
+	UVs.SetNumChannels(1);
+
+	// sections with same material go to same polygon group - single draw call
+	TMap<UMaterialInterface*, FPolygonGroupID> PolygonGroupByMaterial;
+	TArray<FStaticMaterial> StaticMaterials;
+	TArray<FVertexInstanceID> VertexInstanceIDs;
+	int32 NumTriangles = 0;
+
+	for (const UStaticMeshComponent* StaticMeshComponent : Group.Components)
+	{
+		const UStaticMesh* SourceMesh = StaticMeshComponent->GetStaticMesh();
+		const FStaticMeshRenderData* RenderData = SourceMesh->GetRenderData();
+		if (!SourceMesh->bAllowCPUAccess || !RenderData || RenderData->LODResources.IsEmpty())
+		{
+			continue;
+		}
+
+		const int32 LODIndex = FMath::Clamp(StaticMeshLODIndex, 0, RenderData->LODResources.Num() - 1);
+		const FStaticMeshLODResources& LODResources = RenderData->LODResources[LODIndex];
+		const FStaticMeshVertexBuffer& VertexBuffer = LODResources.VertexBuffers.StaticMeshVertexBuffer;
+		const FPositionVertexBuffer& PositionBuffer = LODResources.VertexBuffers.PositionVertexBuffer;
+		const FIndexArrayView Indices = LODResources.IndexBuffer.GetArrayView();
+
+		const FTransform RelativeTransform = StaticMeshComponent->GetComponentTransform().GetRelativeTransform(SocketTransform);
+		const bool bFlipWinding = RelativeTransform.GetDeterminant() < 0.0f;
+
+		const int32 NumVertices = LODResources.GetNumVertices();
+		VertexInstanceIDs.Reset(NumVertices);
+		for (int32 i = 0; i < NumVertices; i++)
+		{
+			const FVertexID VertexID = MeshDescription.CreateVertex();
+			Positions[VertexID] = FVector3f(RelativeTransform.TransformPosition(FVector(PositionBuffer.VertexPosition(i))));
+
+			const FVertexInstanceID VertexInstanceID = MeshDescription.CreateVertexInstance(VertexID);
+			const FVector4f TangentZ = VertexBuffer.VertexTangentZ(i);
+			Normals[VertexInstanceID] = FVector3f(RelativeTransform.TransformVectorNoScale(FVector(TangentZ)));
+			Tangents[VertexInstanceID] = FVector3f(RelativeTransform.TransformVectorNoScale(FVector(VertexBuffer.VertexTangentX(i))));
+			BinormalSigns[VertexInstanceID] = TangentZ.W;
+			UVs.Set(VertexInstanceID, 0, VertexBuffer.GetVertexUV(i, 0));
+			VertexInstanceIDs.Add(VertexInstanceID);
+		}
+
+		for (const FStaticMeshSection& Section : LODResources.Sections)
+		{
+			UMaterialInterface* Material = StaticMeshComponent->GetMaterial(Section.MaterialIndex);
+			FPolygonGroupID* PolygonGroupID = PolygonGroupByMaterial.Find(Material);
+			if (!PolygonGroupID)
+			{
+				const FName SlotName = *FString::Printf(TEXT("Merged_%d"), StaticMaterials.Num());
+				PolygonGroupID = &PolygonGroupByMaterial.Add(Material, MeshDescription.CreatePolygonGroup());
+				MaterialSlotNames[*PolygonGroupID] = SlotName;
+				StaticMaterials.Add(FStaticMaterial(Material, SlotName, SlotName));
+			}
+
+			for (uint32 Triangle = 0; Triangle < Section.NumTriangles; Triangle++)
+			{
+				const uint32 FirstIndex = Section.FirstIndex + Triangle * 3;
+				FVertexInstanceID Corners[3] = {
+					VertexInstanceIDs[Indices[FirstIndex]],
+					VertexInstanceIDs[Indices[FirstIndex + 1]],
+					VertexInstanceIDs[Indices[FirstIndex + 2]],
+				};
+				if (bFlipWinding)
+				{
+					Swap(Corners[1], Corners[2]);
+				}
+				MeshDescription.CreateTriangle(*PolygonGroupID, Corners);
+				NumTriangles++;
+			}
+		}
+	}
+
+	if (NumTriangles == 0)
+	{
+		return nullptr;
+	}
+
+	UStaticMesh* MergedMesh = NewObject<UStaticMesh>(GetTransientPackage(), NAME_None, RF_Transient);
+	MergedMesh->SetStaticMaterials(StaticMaterials);
+	MergedMesh->NeverStream = true;
+
+	UStaticMesh::FBuildMeshDescriptionsParams BuildParams;
+	BuildParams.bFastBuild = true;
+	BuildParams.bBuildSimpleCollision = false;
+	if (!MergedMesh->BuildFromMeshDescriptions({ &MeshDescription }, BuildParams))
+	{
+		return nullptr;
+	}
+
+	if (MergeCache)
+	{
+		MergeCache->AddStaticMesh(MoveTemp(CacheKey), MergedMesh);
+	}
+	return MergedMesh;
+}
+
+USkeletalMesh* UUHLCrowdPropMergeComponent::GetOrBuildMergedSkeletalMesh(const TArray<USkeletalMeshComponent*>& SkeletalProps) const
+{
+	TArray<USkeletalMesh*> SourceMeshes;
+	for (const USkeletalMeshComponent* SkeletalMeshComponent : SkeletalProps)
+	{
+		SourceMeshes.Add(SkeletalMeshComponent->GetSkeletalMeshAsset());
+	}
+	// order doesn't matter for result, sorted to share cache
+	SourceMeshes.Sort();
+
+	UUHLCrowdPropMergeCacheSubsystem* MergeCache = UWorld::GetSubsystem<UUHLCrowdPropMergeCacheSubsystem>(GetWorld());
+
+	FUHLMergedSkeletalMeshKey CacheKey;
+	if (MergeCache)
+	{
+		for (const USkeletalMesh* SourceMesh : SourceMeshes)
+		{
+			CacheKey.Meshes.Add(SourceMesh);
+		}
+		if (USkeletalMesh* CachedMesh = MergeCache->FindSkeletalMesh(CacheKey))
+		{
+			return CachedMesh;
+		}
+	}
+
+	USkeletalMesh* MergedMesh = NewObject<USkeletalMesh>(GetTransientPackage(), NAME_None, RF_Transient);
+	MergedMesh->SetSkeleton(SourceMeshes[0]->GetSkeleton());
+
+	const TArray<FSkelMeshMergeSectionMapping> SectionMappings;
+	FSkeletalMeshMerge MeshMerge(MergedMesh, SourceMeshes, SectionMappings, 0);
+	if (!MeshMerge.DoMerge())
+	{
+		return nullptr;
+	}
+
+	if (MergeCache)
+	{
+		MergeCache->AddSkeletalMesh(MoveTemp(CacheKey), MergedMesh);
+	}
+	return MergedMesh;
+}
@@ -0,0 +1,166 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Components/UHLLocomotionDirectionCacheComponent.h"
+
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "Kismet/GameplayStatics.h"
+#include "Utils/UnrealHelperLibraryBPL.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLLocomotionDirectionCacheComponent)
+
+namespace UHLLocomotionDirectionCache
+{
+	// same collapse as GetEnemyMovementDirectionRelativeToCharacter does
+	EUHLDirection ToFourWay(EUHLDirection Direction)
+	{
+		if (Direction == EUHLDirection::FrontLeft || Direction == EUHLDirection::FrontRight) return EUHLDirection::Front;
+		if (Direction == EUHLDirection::BackLeft || Direction == EUHLDirection::BackRight) return EUHLDirection::Back;
+		return Direction;
+	}
+}
+
+UUHLLocomotionDirectionCacheComponent::UUHLLocomotionDirectionCacheComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = true;
+}
+
+void UUHLLocomotionDirectionCacheComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (ACharacter* Character = Cast<ACharacter>(GetOwner()))
+	{
+		const UGameInstance* GameInstance = GetWorld()->GetGameInstance();
+		if (UEnemyTickOptimizerSubsystem* EnemyTickOptimizer = GameInstance ? GameInstance->GetSubsystem<UEnemyTickOptimizerSubsystem>() : nullptr)
+		{
+			TierChangedHandle = EnemyTickOptimizer->AddOnTierChangedHandler(Character,
+				FOnEnemyTickOptimizerTierChanged::FDelegate::CreateUObject(this, &UUHLLocomotionDirectionCacheComponent::OnTierChanged));
+			const EEnemyTickOptimizerTier CurrentTier = EnemyTickOptimizer->GetEnemyTier(Character);
+			Tier = CurrentTier != EEnemyTickOptimizerTier::None ? CurrentTier : EEnemyTickOptimizerTier::Close;
+		}
+	}
+
+	ForceUpdate();
+}
+
+void UUHLLocomotionDirectionCacheComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	const UGameInstance* GameInstance = GetWorld()->GetGameInstance();
+	if (UEnemyTickOptimizerSubsystem* EnemyTickOptimizer = GameInstance ? GameInstance->GetSubsystem<UEnemyTickOptimizerSubsystem>() : nullptr)
+	{
+		EnemyTickOptimizer->RemoveOnTierChangedHandler(Cast<ACharacter>(GetOwner()), TierChangedHandle);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UUHLLocomotionDirectionCacheComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// component tick interval may be already changed by optimizer, but not necessarily
+	if (GetWorld()->GetTimeSeconds() - Snapshot.UpdateTime >= GetUpdateInterval())
+	{
+		ForceUpdate();
+	}
+}
+
+void UUHLLocomotionDirectionCacheComponent::ForceUpdate()
+{
+	const AActor* Owner = GetOwner();
+	if (!IsValid(Owner))
+	{
+		return;
+	}
+
+	const AActor* RelativeTo = RelativeToActor.Get();
+	if (!RelativeTo && bRelativeToPlayerByDefault)
+	{
+		RelativeTo = UGameplayStatics::GetPlayerCharacter(this, 0);
+	}
+
+	const FVector Velocity = Owner->GetVelocity();
+	const FRotator Rotation = Owner->GetActorRotation();
+
+	FUHLLocomotionDirectionSnapshot NewSnapshot;
+	NewSnapshot.UpdateTime = GetWorld()->GetTimeSeconds();
+	NewSnapshot.Speed = Velocity.Size2D();
+	NewSnapshot.MovementDirection = UUnrealHelperLibraryBPL::GetMovementDirection(Velocity, Rotation, DeadZone);
+	if (bFourWay)
+	{
+		NewSnapshot.MovementDirection = UHLLocomotionDirectionCache::ToFourWay(NewSnapshot.MovementDirection);
+	}
+	if (NewSnapshot.MovementDirection != EUHLDirection::None)
+	{
+		NewSnapshot.RelativeAngle = FMath::UnwindDegrees(Velocity.Rotation().Yaw - Rotation.Yaw);
+	}
+	if (RelativeTo && RelativeTo != Owner)
+	{
+		NewSnapshot.DirectionRelativeToActor = UUnrealHelperLibraryBPL::GetEnemyMovementDirectionRelativeToCharacter(
+			nullptr, Velocity, RelativeTo->GetVelocity(), RelativeTo->GetActorLocation(), RelativeTo->GetActorRotation(),
+			DeadZone, AngleToleranceDeg, bFourWay);
+	}
+	while (NewSnapshot.SpeedBucket < SpeedBucketThresholds.Num() && NewSnapshot.Speed >= SpeedBucketThresholds[NewSnapshot.SpeedBucket])
+	{
+		NewSnapshot.SpeedBucket++;
+	}
+
+	FWriteScopeLock WriteLock(SnapshotLock);
+	Snapshot = NewSnapshot;
+}
+
+FUHLLocomotionDirectionSnapshot UUHLLocomotionDirectionCacheComponent::GetSnapshot() const
+{
+	FReadScopeLock ReadLock(SnapshotLock);
+	return Snapshot;
+}
+
+EUHLDirection UUHLLocomotionDirectionCacheComponent::GetMovementDirection() const
+{
+	FReadScopeLock ReadLock(SnapshotLock);
+	return Snapshot.MovementDirection;
+}
+
+EUHLDirection UUHLLocomotionDirectionCacheComponent::GetDirectionRelativeToActor() const
+{
+	FReadScopeLock ReadLock(SnapshotLock);
+	return Snapshot.DirectionRelativeToActor;
+}
+
+float UUHLLocomotionDirectionCacheComponent::GetRelativeAngle() const
+{
+	FReadScopeLock ReadLock(SnapshotLock);
+	return Snapshot.RelativeAngle;
+}
+
+int32 UUHLLocomotionDirectionCacheComponent::GetSpeedBucket() const
+{
+	FReadScopeLock ReadLock(SnapshotLock);
+	return Snapshot.SpeedBucket;
+}
+
+float UUHLLocomotionDirectionCacheComponent::GetUpdateInterval() const
+{
+	switch (Tier)
+	{
+		case EEnemyTickOptimizerTier::Medium:	return MediumUpdateInterval;
+		case EEnemyTickOptimizerTier::Far:		return FarUpdateInterval;
+		case EEnemyTickOptimizerTier::OutOfRange:
+		case EEnemyTickOptimizerTier::NotRendered:	return HiddenUpdateInterval;
+		default:								return CloseUpdateInterval;
+	}
+}
+
+void UUHLLocomotionDirectionCacheComponent::OnTierChanged(ACharacter* Enemy, EEnemyTickOptimizerTier OldTier, EEnemyTickOptimizerTier NewTier)
+{
+	Tier = NewTier;
+	// promoted enemy shouldn't keep stale direction until next interval
+	if (NewTier < OldTier)
+	{
+		ForceUpdate();
+	}
+}
@@ -0,0 +1,172 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Components/UHLTickSmoothingComponent.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLTickSmoothingComponent)
+
+UUHLTickSmoothingComponent::UUHLTickSmoothingComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	// after movement, so new simulation tick detected in same frame
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
+void UUHLTickSmoothingComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	ACharacter* Character = Cast<ACharacter>(GetOwner());
+	Mesh = Character ? Character->GetMesh() : GetOwner()->FindComponentByClass<USkeletalMeshComponent>();
+	if (!Mesh.IsValid() || Mesh.Get() == GetOwner()->GetRootComponent() || GetOwnerRole() == ROLE_SimulatedProxy)
+	{
+		return;
+	}
+	MeshBaseLocation = Mesh->GetRelativeLocation();
+	MeshBaseRotation = Mesh->GetRelativeRotation().Quaternion();
+
+	if (Character)
+	{
+		const UGameInstance* GameInstance = GetWorld()->GetGameInstance();
+		if (UEnemyTickOptimizerSubsystem* EnemyTickOptimizer = GameInstance ? GameInstance->GetSubsystem<UEnemyTickOptimizerSubsystem>() : nullptr)
+		{
+			TierChangedHandle = EnemyTickOptimizer->AddOnTierChangedHandler(Character,
+				FOnEnemyTickOptimizerTierChanged::FDelegate::CreateUObject(this, &UUHLTickSmoothingComponent::OnTierChanged));
+			SetSmoothing(EnemyTickOptimizer->GetEnemyTier(Character) >= MinSmoothedTier);
+		}
+	}
+}
+
+void UUHLTickSmoothingComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	const UGameInstance* GameInstance = GetWorld()->GetGameInstance();
+	if (UEnemyTickOptimizerSubsystem* EnemyTickOptimizer = GameInstance ? GameInstance->GetSubsystem<UEnemyTickOptimizerSubsystem>() : nullptr)
+	{
+		EnemyTickOptimizer->RemoveOnTierChangedHandler(Cast<ACharacter>(GetOwner()), TierChangedHandle);
+	}
+
+	SetSmoothing(false);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UUHLTickSmoothingComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	USceneComponent* MeshComponent = Mesh.Get();
+	const USceneComponent* Root = GetOwner()->GetRootComponent();
+	if (!MeshComponent || !Root)
+	{
+		return;
+	}
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	const FVector RootLocation = Root->GetComponentLocation();
+	const FQuat RootRotation = Root->GetComponentQuat();
+
+	// capsule moved - owner had simulation tick
+	if (!RootLocation.Equals(LastSample.Location, KINDA_SMALL_NUMBER) || !RootRotation.Equals(LastSample.Rotation, KINDA_SMALL_NUMBER))
+	{
+		const bool bTeleported = FVector::DistSquared(RootLocation, LastSample.Location) > FMath::Square(TeleportDistance);
+		PreviousSample = bTeleported ? FSample{ RootLocation, RootRotation, CurrentTime } : LastSample;
+		LastSample = { RootLocation, RootRotation, CurrentTime };
+	}
+
+	const double SampleInterval = LastSample.Time - PreviousSample.Time;
+	FVector VisualLocation = RootLocation;
+	FQuat VisualRotation = RootRotation;
+	if (SampleInterval > UE_KINDA_SMALL_NUMBER)
+	{
+		const double TimeSinceSample = CurrentTime - LastSample.Time;
+		if (Mode == EUHLTickSmoothingMode::Interpolate)
+		{
+			const float Alpha = FMath::Clamp(TimeSinceSample / SampleInterval, 0.0, 1.0);
+			VisualLocation = FMath::Lerp(PreviousSample.Location, LastSample.Location, Alpha);
+			VisualRotation = FQuat::Slerp(PreviousSample.Rotation, LastSample.Rotation, Alpha);
+		}
+		else
+		{
+			// stopped after last sample - velocity is zero
+			const bool bStillMoving = TimeSinceSample <= SampleInterval * 1.5;
+			const float Alpha = bStillMoving ? FMath::Min(TimeSinceSample, MaxExtrapolationTime) / SampleInterval : 0.0f;
+			VisualLocation = LastSample.Location + (LastSample.Location - PreviousSample.Location) * Alpha;
+			VisualRotation = LastSample.Rotation;
+		}
+	}
+
+	// offset in root space, same as network smoothing does
+	const FVector LocationOffset = RootRotation.UnrotateVector(VisualLocation - RootLocation);
+	const FQuat RotationOffset = bSmoothRotation ? RootRotation.Inverse() * VisualRotation : FQuat::Identity;
+	FVector BaseLocation;
+	FQuat BaseRotation;
+	GetMeshBase(BaseLocation, BaseRotation);
+	MeshComponent->SetRelativeLocationAndRotation(
+		RotationOffset.RotateVector(BaseLocation) + LocationOffset,
+		RotationOffset * BaseRotation);
+}
+
+void UUHLTickSmoothingComponent::SetSmoothing(bool bEnable)
+{
+	if (bSmoothing == bEnable)
+	{
+		return;
+	}
+
+	bSmoothing = bEnable;
+	SetComponentTickEnabled(bEnable);
+	if (bEnable)
+	{
+		ResetSamples();
+	}
+	else
+	{
+		RestoreMesh();
+	}
+}
+
+void UUHLTickSmoothingComponent::ResetSamples()
+{
+	const USceneComponent* Root = GetOwner()->GetRootComponent();
+	if (!Root)
+	{
+		return;
+	}
+
+	LastSample = { Root->GetComponentLocation(), Root->GetComponentQuat(), GetWorld()->GetTimeSeconds() };
+	PreviousSample = LastSample;
+}
+
+void UUHLTickSmoothingComponent::RestoreMesh()
+{
+	if (USceneComponent* MeshComponent = Mesh.Get())
+	{
+		FVector BaseLocation;
+		FQuat BaseRotation;
+		GetMeshBase(BaseLocation, BaseRotation);
+		MeshComponent->SetRelativeLocationAndRotation(BaseLocation, BaseRotation);
+	}
+}
+
+void UUHLTickSmoothingComponent::GetMeshBase(FVector& OutLocation, FQuat& OutRotation) const
+{
+	if (const ACharacter* Character = Cast<ACharacter>(GetOwner()); Character && Character->GetMesh() == Mesh.Get())
+	{
+		OutLocation = Character->GetBaseTranslationOffset();
+		OutRotation = Character->GetBaseRotationOffset();
+		return;
+	}
+	OutLocation = MeshBaseLocation;
+	OutRotation = MeshBaseRotation;
+}
+
+void UUHLTickSmoothingComponent::OnTierChanged(ACharacter* Enemy, EEnemyTickOptimizerTier OldTier, EEnemyTickOptimizerTier NewTier)
+{
+	SetSmoothing(NewTier >= MinSmoothedTier);
+}
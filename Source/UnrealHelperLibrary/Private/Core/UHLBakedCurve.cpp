@@ -0,0 +1,37 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Core/UHLBakedCurve.h"
+
+#include "Curves/RichCurve.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLBakedCurve)
+
+float FUHLBakedCurve::Eval(float Time) const
+{
+	if (Samples.Num() < 2)
+	{
+		return Samples.IsEmpty() ? Time : Samples[0];
+	}
+
+	const float SamplePosition = FMath::Clamp(Time, 0.0f, 1.0f) * (Samples.Num() - 1);
+	const int32 Index = FMath::Min(FMath::FloorToInt32(SamplePosition), Samples.Num() - 2);
+	return FMath::Lerp(Samples[Index], Samples[Index + 1], SamplePosition - Index);
+}
+
+void FUHLBakedCurve::Bake(const FRichCurve* Curve, int32 NumSamples)
+{
+	Samples.Reset();
+	if (!Curve || Curve->GetNumKeys() == 0)
+	{
+		Samples.Shrink();
+		return;
+	}
+
+	NumSamples = FMath::Max(NumSamples, 2);
+	Samples.SetNumUninitialized(NumSamples);
+	for (int32 i = 0; i < NumSamples; i++)
+	{
+		Samples[i] = Curve->Eval(static_cast<float>(i) / (NumSamples - 1));
+	}
+}
@@ -0,0 +1,51 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Core/UHLNotifySignificance.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLNotifySignificance)
+
+bool FUHLNotifySignificance::IsSignificant(const USkeletalMeshComponent* MeshComp) const
+{
+	if (Policy == EUHLNotifySignificancePolicy::Always)
+	{
+		return true;
+	}
+	if (Policy == EUHLNotifySignificancePolicy::GameplayCriticalOnly || !MeshComp)
+	{
+		return false;
+	}
+
+	const UWorld* World = MeshComp->GetWorld();
+	// nobody will see cosmetics on dedicated server
+	if (!World || World->GetNetMode() == NM_DedicatedServer)
+	{
+		return false;
+	}
+
+	const bool bCheckRendered = Policy == EUHLNotifySignificancePolicy::SkipWhenNotRendered
+		|| Policy == EUHLNotifySignificancePolicy::SkipWhenNotRenderedOrBeyondDistance;
+	if (bCheckRendered && !MeshComp->WasRecentlyRendered(RenderedRecentlyTolerance))
+	{
+		return false;
+	}
+
+	const bool bCheckDistance = Policy == EUHLNotifySignificancePolicy::SkipBeyondDistance
+		|| Policy == EUHLNotifySignificancePolicy::SkipWhenNotRenderedOrBeyondDistance;
+	if (bCheckDistance)
+	{
+		const APlayerController* PlayerController = World->GetFirstPlayerController();
+		if (PlayerController && PlayerController->PlayerCameraManager)
+		{
+			const FVector CameraLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+			return FVector::DistSquared(CameraLocation, MeshComp->GetComponentLocation()) <= FMath::Square(MaxDistance);
+		}
+	}
+
+	return true;
+}
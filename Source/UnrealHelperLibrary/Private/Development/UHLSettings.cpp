@@ -3,4 +3,44 @@
 
 #include "Development/UHLSettings.h"
 
-#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLSettings)
\ No newline at end of file
+#include "DeviceProfiles/DeviceProfileManager.h"
+#include "Kismet/GameplayStatics.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLSettings)
+
+namespace UHLSettings
+{
+	int32 GetScalabilityGroupLevel(const Scalability::FQualityLevels& QualityLevels, EEnemyTickOptimizerScalabilityGroup Group)
+	{
+		switch (Group)
+		{
+			case EEnemyTickOptimizerScalabilityGroup::ViewDistance:	return QualityLevels.ViewDistanceQuality;
+			case EEnemyTickOptimizerScalabilityGroup::Shadow:		return QualityLevels.ShadowQuality;
+			case EEnemyTickOptimizerScalabilityGroup::Effects:		return QualityLevels.EffectsQuality;
+			case EEnemyTickOptimizerScalabilityGroup::Foliage:		return QualityLevels.FoliageQuality;
+			case EEnemyTickOptimizerScalabilityGroup::Shading:		return QualityLevels.ShadingQuality;
+			default:												return QualityLevels.GetMinQualityLevel();
+		}
+	}
+}
+
+const FEnemyTickOptimizerSubsystemSettings& UUHLSettings::GetEnemyTickOptimizerSettings(const Scalability::FQualityLevels& QualityLevels) const
+{
+	if (EnemyTickOptimizerSettingsOverrides.IsEmpty())
+	{
+		return EnemyTickOptimizerSubsystemSettings;
+	}
+
+	const FString PlatformName = UGameplayStatics::GetPlatformName();
+	const FString DeviceProfileName = UDeviceProfileManager::Get().GetActiveDeviceProfileName();
+	for (const FEnemyTickOptimizerSettingsOverride& Override : EnemyTickOptimizerSettingsOverrides)
+	{
+		if (Override.bDedicatedServerOnly && !IsRunningDedicatedServer()) continue;
+		if (!Override.Platforms.IsEmpty() && !Override.Platforms.Contains(PlatformName)) continue;
+		if (!Override.DeviceProfiles.IsEmpty() && !Override.DeviceProfiles.Contains(DeviceProfileName)) continue;
+		if (UHLSettings::GetScalabilityGroupLevel(QualityLevels, Override.ScalabilityGroup) > Override.MaxScalabilityLevel) continue;
+
+		return Override.Settings;
+	}
+	return EnemyTickOptimizerSubsystemSettings;
+}
@@ -0,0 +1,309 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Subsystems/ActorTagIndex/UHLActorTagIndexSubsystem.h"
+
+#include "Development/UHLSettings.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameplayTagAssetInterface.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLActorTagIndexSubsystem)
+
+bool UUHLActorTagIndexSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && GetDefault<UUHLSettings>()->ActorTagIndexSettings.bEnable;
+}
+
+void UUHLActorTagIndexSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Settings = GetDefault<UUHLSettings>()->ActorTagIndexSettings;
+
+	UWorld* World = GetWorld();
+	ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UUHLActorTagIndexSubsystem::OnActorSpawned));
+	ActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &UUHLActorTagIndexSubsystem::OnActorDestroyed));
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UUHLActorTagIndexSubsystem::OnLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UUHLActorTagIndexSubsystem::OnLevelRemoved);
+}
+
+void UUHLActorTagIndexSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+	IndexedActors.Empty();
+	ActorsByTag.Empty();
+	ActorsByGameplayTag.Empty();
+
+	Super::Deinitialize();
+}
+
+void UUHLActorTagIndexSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// actors loaded with levels aren't spawned, index them once
+	for (ULevel* Level : InWorld.GetLevels())
+	{
+		OnLevelAdded(Level, &InWorld);
+	}
+}
+
+bool UUHLActorTagIndexSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UUHLActorTagIndexSubsystem::GetActorsWithTag(FName Tag, TArray<AActor*>& OutActors) const
+{
+	OutActors.Reset();
+
+	if (const TArray<TWeakObjectPtr<AActor>>* Actors = ActorsByTag.Find(Tag))
+	{
+		for (const TWeakObjectPtr<AActor>& Actor : *Actors)
+		{
+			if (AActor* ActorPtr = Actor.Get())
+			{
+				OutActors.Add(ActorPtr);
+			}
+		}
+	}
+}
+
+void UUHLActorTagIndexSubsystem::GetActorsWithGameplayTag(FGameplayTag GameplayTag, bool bExactMatch, TArray<AActor*>& OutActors) const
+{
+	OutActors.Reset();
+
+	const TArray<TWeakObjectPtr<AActor>>* Actors = ActorsByGameplayTag.Find(GameplayTag);
+	if (!Actors)
+	{
+		return;
+	}
+
+	for (const TWeakObjectPtr<AActor>& Actor : *Actors)
+	{
+		AActor* ActorPtr = Actor.Get();
+		if (!ActorPtr)
+		{
+			continue;
+		}
+		if (bExactMatch)
+		{
+			const FIndexedActor* IndexedActor = IndexedActors.Find(ActorPtr);
+			if (!IndexedActor || !IndexedActor->GameplayTags.HasTagExact(GameplayTag))
+			{
+				continue;
+			}
+		}
+		OutActors.Add(ActorPtr);
+	}
+}
+
+AActor* UUHLActorTagIndexSubsystem::FindActorWithTag(FName Tag) const
+{
+	if (const TArray<TWeakObjectPtr<AActor>>* Actors = ActorsByTag.Find(Tag))
+	{
+		for (const TWeakObjectPtr<AActor>& Actor : *Actors)
+		{
+			if (AActor* ActorPtr = Actor.Get())
+			{
+				return ActorPtr;
+			}
+		}
+	}
+	return nullptr;
+}
+
+AActor* UUHLActorTagIndexSubsystem::FindAttachedActorWithTag(const AActor* Parent, FName Tag) const
+{
+	if (!IsValid(Parent))
+	{
+		return nullptr;
+	}
+
+	if (const TArray<TWeakObjectPtr<AActor>>* Actors = ActorsByTag.Find(Tag))
+	{
+		for (const TWeakObjectPtr<AActor>& Actor : *Actors)
+		{
+			AActor* ActorPtr = Actor.Get();
+			if (ActorPtr && ActorPtr != Parent && ActorPtr->IsAttachedTo(Parent))
+			{
+				return ActorPtr;
+			}
+		}
+	}
+	return nullptr;
+}
+
+void UUHLActorTagIndexSubsystem::AddActorTag(AActor* Actor, FName Tag)
+{
+	if (!IsValid(Actor) || Tag.IsNone() || Actor->Tags.Contains(Tag))
+	{
+		return;
+	}
+
+	Actor->Tags.Add(Tag);
+	if (FIndexedActor* IndexedActor = IndexedActors.Find(Actor))
+	{
+		IndexedActor->Tags.Add(Tag);
+		ActorsByTag.FindOrAdd(Tag).Add(Actor);
+	}
+	else
+	{
+		AddActor(Actor);
+	}
+}
+
+void UUHLActorTagIndexSubsystem::RemoveActorTag(AActor* Actor, FName Tag)
+{
+	if (!IsValid(Actor) || Actor->Tags.Remove(Tag) == 0)
+	{
+		return;
+	}
+
+	if (FIndexedActor* IndexedActor = IndexedActors.Find(Actor))
+	{
+		IndexedActor->Tags.RemoveSwap(Tag);
+		if (TArray<TWeakObjectPtr<AActor>>* Actors = ActorsByTag.Find(Tag))
+		{
+			Actors->RemoveSwap(Actor);
+		}
+	}
+}
+
+void UUHLActorTagIndexSubsystem::UpdateActorTags(AActor* Actor)
+{
+	RemoveActor(Actor);
+	AddActor(Actor);
+}
+
+void UUHLActorTagIndexSubsystem::AddActor(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	FIndexedActor IndexedActor;
+	IndexedActor.Tags = Actor->Tags;
+
+	if (Settings.bIndexGameplayTags)
+	{
+		if (const IGameplayTagAssetInterface* GameplayTagAsset = Cast<IGameplayTagAssetInterface>(Actor))
+		{
+			GameplayTagAsset->GetOwnedGameplayTags(IndexedActor.GameplayTags);
+		}
+	}
+
+	if (IndexedActor.Tags.IsEmpty() && IndexedActor.GameplayTags.IsEmpty())
+	{
+		return;
+	}
+
+	for (const FName& Tag : IndexedActor.Tags)
+	{
+		ActorsByTag.FindOrAdd(Tag).AddUnique(Actor);
+	}
+	// parents included, so non-exact queries are single lookup
+	for (const FGameplayTag& GameplayTag : IndexedActor.GameplayTags.GetGameplayTagParents())
+	{
+		ActorsByGameplayTag.FindOrAdd(GameplayTag).Add(Actor);
+	}
+
+	IndexedActors.Add(Actor, MoveTemp(IndexedActor));
+}
+
+void UUHLActorTagIndexSubsystem::RemoveActor(AActor* Actor)
+{
+	FIndexedActor IndexedActor;
+	if (!IndexedActors.RemoveAndCopyValue(Actor, IndexedActor))
+	{
+		return;
+	}
+
+	// compared by index/serial, weak pointers of destroyed actor are already stale
+	const TWeakObjectPtr<AActor> ActorWeak(Actor);
+	const auto IsActor = [&ActorWeak](const TWeakObjectPtr<AActor>& Other) { return Other.HasSameIndexAndSerialNumber(ActorWeak); };
+
+	for (const FName& Tag : IndexedActor.Tags)
+	{
+		if (TArray<TWeakObjectPtr<AActor>>* Actors = ActorsByTag.Find(Tag))
+		{
+			Actors->RemoveAllSwap(IsActor);
+			if (Actors->IsEmpty())
+			{
+				ActorsByTag.Remove(Tag);
+			}
+		}
+	}
+	for (const FGameplayTag& GameplayTag : IndexedActor.GameplayTags.GetGameplayTagParents())
+	{
+		if (TArray<TWeakObjectPtr<AActor>>* Actors = ActorsByGameplayTag.Find(GameplayTag))
+		{
+			Actors->RemoveAllSwap(IsActor);
+			if (Actors->IsEmpty())
+			{
+				ActorsByGameplayTag.Remove(GameplayTag);
+			}
+		}
+	}
+}
+
+void UUHLActorTagIndexSubsystem::OnActorSpawned(AActor* Actor)
+{
+	AddActor(Actor);
+}
+
+void UUHLActorTagIndexSubsystem::OnActorDestroyed(AActor* Actor)
+{
+	RemoveActor(Actor);
+}
+
+void UUHLActorTagIndexSubsystem::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+	if (!Level || World != GetWorld())
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (Actor && !IndexedActors.Contains(Actor))
+		{
+			AddActor(Actor);
+		}
+	}
+}
+
+void UUHLActorTagIndexSubsystem::OnLevelRemoved(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	// null level means all levels removed
+	if (!Level)
+	{
+		IndexedActors.Empty();
+		ActorsByTag.Empty();
+		ActorsByGameplayTag.Empty();
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (Actor)
+		{
+			RemoveActor(Actor);
+		}
+	}
+}
@@ -0,0 +1,328 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Subsystems/ArchetypePreload/UHLArchetypePreloadSubsystem.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Development/UHLSettings.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "UnrealHelperLibrary.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLArchetypePreloadSubsystem)
+
+void UUHLArchetypePreloadSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Settings = GetDefault<UUHLSettings>()->ArchetypePreloadSettings;
+}
+
+void UUHLArchetypePreloadSubsystem::Deinitialize()
+{
+	for (TPair<FName, FPreload>& Preload : Preloads)
+	{
+		CancelPreload(Preload.Value);
+	}
+	Preloads.Empty();
+	UsedBudgetBytes = 0;
+
+	Super::Deinitialize();
+}
+
+void UUHLArchetypePreloadSubsystem::PreloadArchetypes(FName PreloadId, const TArray<TSoftClassPtr<UObject>>& ArchetypeClasses,
+	const TArray<TSoftObjectPtr<UObject>>& ArchetypeAssets, int32 Priority, const TArray<FName>& Bundles)
+{
+	ReleasePreload(PreloadId);
+
+	TArray<FSoftObjectPath> RootPaths;
+	for (const TSoftClassPtr<UObject>& ArchetypeClass : ArchetypeClasses)
+	{
+		if (!ArchetypeClass.IsNull())
+		{
+			RootPaths.AddUnique(ArchetypeClass.ToSoftObjectPath());
+		}
+	}
+	for (const TSoftObjectPtr<UObject>& ArchetypeAsset : ArchetypeAssets)
+	{
+		if (!ArchetypeAsset.IsNull())
+		{
+			RootPaths.AddUnique(ArchetypeAsset.ToSoftObjectPath());
+		}
+	}
+
+	FPreload Preload;
+	Preload.Id = PreloadId;
+	Preload.Priority = Priority;
+	Preload.State = EUHLArchetypePreloadState::Queued;
+	ResolveDependencies(Preload, RootPaths, Bundles.IsEmpty() ? Settings.DefaultBundles : Bundles);
+
+	Preloads.Add(PreloadId, MoveTemp(Preload));
+	StartQueuedPreloads();
+}
+
+void UUHLArchetypePreloadSubsystem::ReleasePreload(FName PreloadId)
+{
+	FPreload Preload;
+	if (!Preloads.RemoveAndCopyValue(PreloadId, Preload))
+	{
+		return;
+	}
+
+	CancelPreload(Preload);
+	StartQueuedPreloads();
+}
+
+EUHLArchetypePreloadState UUHLArchetypePreloadSubsystem::GetPreloadState(FName PreloadId) const
+{
+	const FPreload* Preload = Preloads.Find(PreloadId);
+	return Preload ? Preload->State : EUHLArchetypePreloadState::None;
+}
+
+float UUHLArchetypePreloadSubsystem::GetPreloadProgress(FName PreloadId) const
+{
+	const FPreload* Preload = Preloads.Find(PreloadId);
+	if (!Preload || Preload->State == EUHLArchetypePreloadState::Queued || Preload->State == EUHLArchetypePreloadState::None)
+	{
+		return 0.0f;
+	}
+	if (Preload->State == EUHLArchetypePreloadState::Ready || !Preload->Handle.IsValid())
+	{
+		return 1.0f;
+	}
+	return Preload->Handle->GetProgress();
+}
+
+void UUHLArchetypePreloadSubsystem::ResolveDependencies(FPreload& Preload, const TArray<FSoftObjectPath>& RootPaths, const TArray<FName>& Bundles) const
+{
+	TArray<FSoftObjectPath> Paths = RootPaths;
+
+	// primary data assets bring assets from requested bundles
+	if (UAssetManager::IsInitialized() && !Bundles.IsEmpty())
+	{
+		UAssetManager& AssetManager = UAssetManager::Get();
+		for (const FSoftObjectPath& RootPath : RootPaths)
+		{
+			const FPrimaryAssetId PrimaryAssetId = AssetManager.GetPrimaryAssetIdForPath(RootPath);
+			if (!PrimaryAssetId.IsValid())
+			{
+				continue;
+			}
+			for (const FName& Bundle : Bundles)
+			{
+				for (const auto& BundleAssetPath : AssetManager.GetAssetBundleEntry(PrimaryAssetId, Bundle).AssetPaths)
+				{
+					Paths.AddUnique(FSoftObjectPath(BundleAssetPath));
+				}
+			}
+		}
+	}
+
+	Preload.Paths = Paths;
+
+	IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+	if (!AssetRegistry)
+	{
+		return;
+	}
+
+	// package -> soft reference depth it was reached with
+	TArray<TPair<FName, int32>> Stack;
+	for (const FSoftObjectPath& Path : Paths)
+	{
+		Stack.Emplace(Path.GetLongPackageFName(), 0);
+	}
+
+	TSet<FName> VisitedPackages;
+	int32 PackagesWithoutSize = 0;
+	int64 DiskSize = 0;
+	TArray<FAssetDependency> Dependencies;
+	TArray<FAssetData> PackageAssets;
+	while (!Stack.IsEmpty())
+	{
+		const TPair<FName, int32> Entry = Stack.Pop(EAllowShrinking::No);
+		bool bAlreadyVisited = false;
+		VisitedPackages.Add(Entry.Key, &bAlreadyVisited);
+		if (bAlreadyVisited)
+		{
+			continue;
+		}
+
+		const TOptional<FAssetPackageData> PackageData = AssetRegistry->GetAssetPackageDataCopy(Entry.Key);
+		if (PackageData.IsSet() && PackageData->DiskSize > 0)
+		{
+			DiskSize += PackageData->DiskSize;
+		}
+		else
+		{
+			PackagesWithoutSize++;
+		}
+
+		Dependencies.Reset();
+		AssetRegistry->GetDependencies(FAssetIdentifier(Entry.Key), Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+		for (const FAssetDependency& Dependency : Dependencies)
+		{
+			const FName DependencyPackage = Dependency.AssetId.PackageName;
+			if (DependencyPackage.IsNone() || DependencyPackage.ToString().StartsWith(TEXT("/Script/")))
+			{
+				continue;
+			}
+
+			// hard references are loaded with package anyway, only counted for budget
+			if (EnumHasAnyFlags(Dependency.Properties, UE::AssetRegistry::EDependencyProperty::Hard))
+			{
+				Stack.Emplace(DependencyPackage, Entry.Value);
+			}
+			else if (Entry.Value < Settings.SoftReferenceDepth && !VisitedPackages.Contains(DependencyPackage))
+			{
+				Stack.Emplace(DependencyPackage, Entry.Value + 1);
+
+				PackageAssets.Reset();
+				AssetRegistry->GetAssetsByPackageName(DependencyPackage, PackageAssets);
+				for (const FAssetData& PackageAsset : PackageAssets)
+				{
+					Preload.Paths.AddUnique(PackageAsset.GetSoftObjectPath());
+				}
+			}
+		}
+	}
+
+	Preload.EstimatedSize = static_cast<int64>(DiskSize * Settings.DiskSizeToMemoryScale)
+		+ static_cast<int64>(PackagesWithoutSize) * Settings.FallbackPackageSizeKB * 1024;
+
+	if (PackagesWithoutSize > 0)
+	{
+		UE_LOG(LogUnrealHelperLibrary, Warning, TEXT("ArchetypePreload: \"%s\" size unknown for %d of %d packages, estimated by FallbackPackageSizeKB"),
+			*Preload.Id.ToString(), PackagesWithoutSize, VisitedPackages.Num());
+	}
+}
+
+void UUHLArchetypePreloadSubsystem::StartQueuedPreloads()
+{
+	TArray<TPair<int32, FName>> QueuedPreloads;
+	for (const TPair<FName, FPreload>& Preload : Preloads)
+	{
+		if (Preload.Value.State == EUHLArchetypePreloadState::Queued)
+		{
+			QueuedPreloads.Emplace(Preload.Value.Priority, Preload.Key);
+		}
+	}
+	QueuedPreloads.Sort([](const TPair<int32, FName>& A, const TPair<int32, FName>& B) { return A.Key > B.Key; });
+
+	const int64 BudgetBytes = static_cast<int64>(Settings.MemoryBudgetMB) * 1024 * 1024;
+	for (const TPair<int32, FName>& QueuedPreload : QueuedPreloads)
+	{
+		const FPreload* Preload = Preloads.Find(QueuedPreload.Value);
+		// may be evicted back to queue or started by recursion
+		if (!Preload || Preload->State != EUHLArchetypePreloadState::Queued)
+		{
+			continue;
+		}
+
+		const int64 RequiredBytes = UsedBudgetBytes + Preload->EstimatedSize - BudgetBytes;
+		// preload bigger than whole budget still loaded alone, otherwise it'd never be
+		if (RequiredBytes > 0 && !TryFreeBudget(RequiredBytes, Preload->Priority) && UsedBudgetBytes > 0)
+		{
+			continue;
+		}
+
+		StartPreload(Preloads.FindChecked(QueuedPreload.Value));
+	}
+}
+
+bool UUHLArchetypePreloadSubsystem::TryFreeBudget(int64 RequiredBytes, int32 Priority)
+{
+	if (!Settings.bEvictLowerPriority)
+	{
+		return false;
+	}
+
+	TArray<FPreload*> Candidates;
+	int64 CandidatesBytes = 0;
+	for (TPair<FName, FPreload>& Preload : Preloads)
+	{
+		if (Preload.Value.Priority < Priority
+			&& (Preload.Value.State == EUHLArchetypePreloadState::Loading || Preload.Value.State == EUHLArchetypePreloadState::Ready))
+		{
+			Candidates.Add(&Preload.Value);
+			CandidatesBytes += Preload.Value.EstimatedSize;
+		}
+	}
+	if (CandidatesBytes < RequiredBytes)
+	{
+		return false;
+	}
+
+	// lowest priority evicted first, evicted preloads wait in queue for budget again
+	Candidates.Sort([](const FPreload& A, const FPreload& B) { return A.Priority < B.Priority; });
+	for (FPreload* Candidate : Candidates)
+	{
+		if (RequiredBytes <= 0)
+		{
+			break;
+		}
+		RequiredBytes -= Candidate->EstimatedSize;
+		CancelPreload(*Candidate);
+		Candidate->State = EUHLArchetypePreloadState::Queued;
+		UE_LOG(LogUnrealHelperLibrary, Log, TEXT("ArchetypePreload: \"%s\" evicted to fit budget"), *Candidate->Id.ToString());
+	}
+	return true;
+}
+
+void UUHLArchetypePreloadSubsystem::StartPreload(FPreload& Preload)
+{
+	UsedBudgetBytes += Preload.EstimatedSize;
+
+	if (!Preload.Paths.IsEmpty())
+	{
+		// state stays Queued until handle created, in case of loaded assets delegate is called immediately
+		Preload.Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+			Preload.Paths,
+			FStreamableDelegate::CreateUObject(this, &UUHLArchetypePreloadSubsystem::OnPreloadHandleCompleted, Preload.Id),
+			FStreamableManager::DefaultAsyncLoadPriority + Preload.Priority,
+			false,
+			false,
+			FString::Printf(TEXT("UHLArchetypePreload %s"), *Preload.Id.ToString()));
+	}
+
+	Preload.State = EUHLArchetypePreloadState::Loading;
+	OnPreloadHandleCompleted(Preload.Id);
+}
+
+void UUHLArchetypePreloadSubsystem::OnPreloadHandleCompleted(FName PreloadId)
+{
+	FPreload* Preload = Preloads.Find(PreloadId);
+	if (!Preload || Preload->State != EUHLArchetypePreloadState::Loading)
+	{
+		return;
+	}
+	if (Preload->Handle.IsValid() && !Preload->Handle->HasLoadCompleted())
+	{
+		return;
+	}
+
+	Preload->State = EUHLArchetypePreloadState::Ready;
+	OnPreloadReady.Broadcast(PreloadId);
+}
+
+void UUHLArchetypePreloadSubsystem::CancelPreload(FPreload& Preload)
+{
+	if (Preload.State == EUHLArchetypePreloadState::Loading || Preload.State == EUHLArchetypePreloadState::Ready)
+	{
+		UsedBudgetBytes -= Preload.EstimatedSize;
+	}
+
+	if (Preload.Handle.IsValid())
+	{
+		if (Preload.Handle->IsLoadingInProgress())
+		{
+			Preload.Handle->CancelHandle();
+		}
+		else
+		{
+			Preload.Handle->ReleaseHandle();
+		}
+		Preload.Handle.Reset();
+	}
+	Preload.State = EUHLArchetypePreloadState::None;
+}
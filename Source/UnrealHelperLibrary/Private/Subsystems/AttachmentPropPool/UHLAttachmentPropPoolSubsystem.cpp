@@ -0,0 +1,259 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Subsystems/AttachmentPropPool/UHLAttachmentPropPoolSubsystem.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Core/UHLAttachmentPropData.h"
+#include "Development/UHLSettings.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Materials/MaterialInterface.h"
+#include "TimerManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLAttachmentPropPoolSubsystem)
+
+void UUHLAttachmentPropPoolSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Settings = GetDefault<UUHLSettings>()->AttachmentPropPoolSettings;
+}
+
+void UUHLAttachmentPropPoolSubsystem::Deinitialize()
+{
+	ActiveProps.Empty();
+	FreeComponents.Empty();
+	NumFreeComponents = 0;
+	PoolActor = nullptr;
+
+	Super::Deinitialize();
+}
+
+bool UUHLAttachmentPropPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+UMeshComponent* UUHLAttachmentPropPoolSubsystem::AttachProp(AActor* Owner, const UUHLAttachmentPropData* PropData, USceneComponent* AttachParent, FName SocketName, FName UniqueId, EAttachmentRule AttachmentRule)
+{
+	if (!IsValid(Owner) || !PropData || !IsValid(AttachParent))
+	{
+		return nullptr;
+	}
+
+	ReleaseProp(Owner, UniqueId);
+
+	UMeshComponent* MeshComponent = AcquireComponent(PropData);
+	if (!MeshComponent)
+	{
+		return nullptr;
+	}
+
+	MeshComponent->AttachToComponent(AttachParent, FAttachmentTransformRules(AttachmentRule, true), SocketName);
+	MeshComponent->SetRelativeTransform(PropData->RelativeTransform);
+	MeshComponent->SetVisibility(true);
+	MeshComponent->ComponentTags.AddUnique(UniqueId);
+
+	FActiveProp& ActiveProp = ActiveProps.Add({ Owner, UniqueId });
+	ActiveProp.Component = MeshComponent;
+	ActiveProp.PropData = PropData;
+
+	Owner->OnEndPlay.AddUniqueDynamic(this, &UUHLAttachmentPropPoolSubsystem::OnOwnerEndPlay);
+	return MeshComponent;
+}
+
+UMeshComponent* UUHLAttachmentPropPoolSubsystem::FindProp(const AActor* Owner, FName UniqueId) const
+{
+	const FActiveProp* ActiveProp = ActiveProps.Find({ Owner, UniqueId });
+	return ActiveProp ? ActiveProp->Component.Get() : nullptr;
+}
+
+UMeshComponent* UUHLAttachmentPropPoolSubsystem::DetachProp(const AActor* Owner, FName UniqueId, EDetachmentRule DetachmentRule)
+{
+	UMeshComponent* MeshComponent = FindProp(Owner, UniqueId);
+	if (MeshComponent)
+	{
+		MeshComponent->DetachFromComponent(FDetachmentTransformRules(DetachmentRule, true));
+	}
+	return MeshComponent;
+}
+
+void UUHLAttachmentPropPoolSubsystem::ReleaseProp(const AActor* Owner, FName UniqueId)
+{
+	ReleaseActiveProp({ Owner, UniqueId }, nullptr);
+}
+
+void UUHLAttachmentPropPoolSubsystem::ReleasePropDelayed(const AActor* Owner, FName UniqueId, float Delay)
+{
+	const FPropKey PropKey{ Owner, UniqueId };
+	FActiveProp* ActiveProp = ActiveProps.Find(PropKey);
+	if (!ActiveProp)
+	{
+		return;
+	}
+
+	const TWeakObjectPtr<UMeshComponent> WeakComponent = ActiveProp->Component;
+	GetWorld()->GetTimerManager().SetTimer(ActiveProp->ReleaseTimerHandle, FTimerDelegate::CreateWeakLambda(this, [this, PropKey, WeakComponent]()
+	{
+		ReleaseActiveProp(PropKey, &WeakComponent);
+	}), Delay, false);
+}
+
+void UUHLAttachmentPropPoolSubsystem::ReleaseActiveProp(const FPropKey& PropKey, const TWeakObjectPtr<UMeshComponent>* ExpectedComponent)
+{
+	FActiveProp* ActiveProp = ActiveProps.Find(PropKey);
+	if (!ActiveProp || (ExpectedComponent && ActiveProp->Component != *ExpectedComponent))
+	{
+		return;
+	}
+
+	ClearReleaseTimer(*ActiveProp);
+	if (UMeshComponent* MeshComponent = ActiveProp->Component.Get())
+	{
+		MeshComponent->ComponentTags.Remove(PropKey.UniqueId);
+		ReleaseComponent(MeshComponent, ActiveProp->PropData);
+	}
+	ActiveProps.Remove(PropKey);
+}
+
+void UUHLAttachmentPropPoolSubsystem::ClearReleaseTimer(FActiveProp& ActiveProp) const
+{
+	if (ActiveProp.ReleaseTimerHandle.IsValid())
+	{
+		GetWorld()->GetTimerManager().ClearTimer(ActiveProp.ReleaseTimerHandle);
+	}
+}
+
+void UUHLAttachmentPropPoolSubsystem::ReleaseAllProps(const AActor* Owner)
+{
+	const TObjectKey<AActor> OwnerKey(Owner);
+	for (auto It = ActiveProps.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Owner != OwnerKey)
+		{
+			continue;
+		}
+
+		ClearReleaseTimer(It.Value());
+		if (UMeshComponent* MeshComponent = It.Value().Component.Get())
+		{
+			MeshComponent->ComponentTags.Remove(It.Key().UniqueId);
+			ReleaseComponent(MeshComponent, It.Value().PropData);
+		}
+		It.RemoveCurrent();
+	}
+}
+
+AActor* UUHLAttachmentPropPoolSubsystem::GetOrCreatePoolActor()
+{
+	if (!IsValid(PoolActor))
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+#if WITH_EDITOR
+		SpawnParameters.bHideFromSceneOutliner = true;
+#endif
+		PoolActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+		if (PoolActor)
+		{
+			PoolActor->SetRootComponent(NewObject<USceneComponent>(PoolActor, TEXT("Root")));
+			PoolActor->GetRootComponent()->RegisterComponent();
+		}
+		FreeComponents.Reset();
+		NumFreeComponents = 0;
+	}
+	return PoolActor;
+}
+
+UMeshComponent* UUHLAttachmentPropPoolSubsystem::AcquireComponent(const UUHLAttachmentPropData* PropData)
+{
+	// same prop - already set up
+	if (TArray<TWeakObjectPtr<UMeshComponent>>* FreeList = FreeComponents.Find(PropData))
+	{
+		while (!FreeList->IsEmpty())
+		{
+			NumFreeComponents--;
+			if (UMeshComponent* MeshComponent = FreeList->Pop(EAllowShrinking::No).Get())
+			{
+				return MeshComponent;
+			}
+		}
+	}
+
+	AActor* Pool = GetOrCreatePoolActor();
+	if (!Pool)
+	{
+		return nullptr;
+	}
+
+	UMeshComponent* MeshComponent = nullptr;
+	if (PropData->IsSkeletal())
+	{
+		MeshComponent = NewObject<USkeletalMeshComponent>(Pool);
+	}
+	else
+	{
+		MeshComponent = NewObject<UStaticMeshComponent>(Pool);
+	}
+	Pool->AddInstanceComponent(MeshComponent);
+	MeshComponent->RegisterComponent();
+
+	SetupComponent(MeshComponent, PropData);
+	return MeshComponent;
+}
+
+void UUHLAttachmentPropPoolSubsystem::SetupComponent(UMeshComponent* MeshComponent, const UUHLAttachmentPropData* PropData) const
+{
+	if (UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(MeshComponent))
+	{
+		StaticMeshComponent->SetStaticMesh(PropData->StaticMesh.LoadSynchronous());
+	}
+	else if (USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(MeshComponent))
+	{
+		SkeletalMeshComponent->SetSkeletalMeshAsset(PropData->SkeletalMesh.LoadSynchronous());
+	}
+
+	for (int32 i = 0; i < PropData->OverrideMaterials.Num(); i++)
+	{
+		if (UMaterialInterface* Material = PropData->OverrideMaterials[i].LoadSynchronous())
+		{
+			MeshComponent->SetMaterial(i, Material);
+		}
+	}
+
+	MeshComponent->SetCastShadow(PropData->bCastShadow);
+	MeshComponent->SetCollisionProfileName(PropData->CollisionProfileName);
+}
+
+void UUHLAttachmentPropPoolSubsystem::ReleaseComponent(UMeshComponent* MeshComponent, const TObjectKey<UUHLAttachmentPropData>& PropData)
+{
+	if (MeshComponent->IsSimulatingPhysics())
+	{
+		MeshComponent->SetSimulatePhysics(false);
+	}
+	// may have been changed by detach notify
+	if (const UUHLAttachmentPropData* PropDataObject = PropData.ResolveObjectPtr())
+	{
+		MeshComponent->SetCollisionProfileName(PropDataObject->CollisionProfileName);
+	}
+
+	if (NumFreeComponents >= Settings.MaxFreeComponents || !IsValid(PoolActor) || MeshComponent->GetOwner() != PoolActor)
+	{
+		MeshComponent->DestroyComponent();
+		return;
+	}
+
+	MeshComponent->AttachToComponent(PoolActor->GetRootComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	MeshComponent->SetVisibility(false);
+
+	FreeComponents.FindOrAdd(PropData).Add(MeshComponent);
+	NumFreeComponents++;
+}
+
+void UUHLAttachmentPropPoolSubsystem::OnOwnerEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	ReleaseAllProps(Actor);
+}
@@ -0,0 +1,111 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Subsystems/CrowdPropMerge/UHLCrowdPropMergeCacheSubsystem.h"
+
+#include "Engine/SkeletalMesh.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLCrowdPropMergeCacheSubsystem)
+
+bool FUHLMergedStaticPropDesc::operator<(const FUHLMergedStaticPropDesc& Other) const
+{
+	const uint32 Hash = GetTypeHash(*this);
+	const uint32 OtherHash = GetTypeHash(Other);
+	if (Hash != OtherHash)
+	{
+		return Hash < OtherHash;
+	}
+	// same hash, order by contents so equal sets always sort same way
+	if (Location != Other.Location)
+	{
+		return Location.X != Other.Location.X ? Location.X < Other.Location.X : (Location.Y != Other.Location.Y ? Location.Y < Other.Location.Y : Location.Z < Other.Location.Z);
+	}
+	if (Rotation != Other.Rotation)
+	{
+		return Rotation.X != Other.Rotation.X ? Rotation.X < Other.Rotation.X : (Rotation.Y != Other.Rotation.Y ? Rotation.Y < Other.Rotation.Y : Rotation.Z < Other.Rotation.Z);
+	}
+	return Scale.X != Other.Scale.X ? Scale.X < Other.Scale.X : (Scale.Y != Other.Scale.Y ? Scale.Y < Other.Scale.Y : Scale.Z < Other.Scale.Z);
+}
+
+uint32 GetTypeHash(const FUHLMergedStaticPropDesc& Desc)
+{
+	uint32 Hash = GetTypeHash(Desc.Mesh);
+	for (const TObjectKey<UMaterialInterface>& Material : Desc.Materials)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Material));
+	}
+	Hash = HashCombine(Hash, GetTypeHash(Desc.Location));
+	Hash = HashCombine(Hash, GetTypeHash(Desc.Rotation));
+	return HashCombine(Hash, GetTypeHash(Desc.Scale));
+}
+
+uint32 GetTypeHash(const FUHLMergedStaticMeshKey& Key)
+{
+	uint32 Hash = ::GetTypeHash(Key.LODIndex);
+	for (const FUHLMergedStaticPropDesc& Prop : Key.Props)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Prop));
+	}
+	return Hash;
+}
+
+uint32 GetTypeHash(const FUHLMergedSkeletalMeshKey& Key)
+{
+	uint32 Hash = 0;
+	for (const TObjectKey<USkeletalMesh>& Mesh : Key.Meshes)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Mesh));
+	}
+	return Hash;
+}
+
+void UUHLCrowdPropMergeCacheSubsystem::Deinitialize()
+{
+	StaticMeshes.Empty();
+	SkeletalMeshes.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UUHLCrowdPropMergeCacheSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+UStaticMesh* UUHLCrowdPropMergeCacheSubsystem::FindStaticMesh(const FUHLMergedStaticMeshKey& Key) const
+{
+	const TWeakObjectPtr<UStaticMesh>* CachedMesh = StaticMeshes.Find(Key);
+	return CachedMesh ? CachedMesh->Get() : nullptr;
+}
+
+void UUHLCrowdPropMergeCacheSubsystem::AddStaticMesh(FUHLMergedStaticMeshKey&& Key, UStaticMesh* Mesh)
+{
+	RemoveStaleEntries(StaticMeshes);
+	StaticMeshes.Add(MoveTemp(Key), Mesh);
+}
+
+USkeletalMesh* UUHLCrowdPropMergeCacheSubsystem::FindSkeletalMesh(const FUHLMergedSkeletalMeshKey& Key) const
+{
+	const TWeakObjectPtr<USkeletalMesh>* CachedMesh = SkeletalMeshes.Find(Key);
+	return CachedMesh ? CachedMesh->Get() : nullptr;
+}
+
+void UUHLCrowdPropMergeCacheSubsystem::AddSkeletalMesh(FUHLMergedSkeletalMeshKey&& Key, USkeletalMesh* Mesh)
+{
+	RemoveStaleEntries(SkeletalMeshes);
+	SkeletalMeshes.Add(MoveTemp(Key), Mesh);
+}
+
+template <typename MapType>
+void UUHLCrowdPropMergeCacheSubsystem::RemoveStaleEntries(MapType& Map)
+{
+	for (auto It = Map.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,273 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Subsystems/DebugGraph/UHLDebugGraphSubsystem.h"
+
+#include "CanvasItem.h"
+#include "Debug/DebugDrawService.h"
+#include "Development/UHLSettings.h"
+#include "Engine/Engine.h"
+#include "Engine/Font.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLDebugGraphSubsystem)
+
+static TAutoConsoleVariable<int32> CVarUHLDebugGraph(
+	TEXT("UHL.DebugGraph"),
+	-1,
+	TEXT("Shows UHL debug graphs.\n")
+	TEXT("-1: use UUHLDebugGraphSubsystem visibility (default)\n")
+	TEXT(" 0: hidden\n")
+	TEXT(" 1: shown"),
+	ECVF_Cheat);
+
+static const FName FrameTimeMetricName = TEXT("FrameTime");
+
+bool UUHLDebugGraphSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UHL_DEBUG_GRAPH_ENABLED
+	return Super::ShouldCreateSubsystem(Outer);
+#else
+	return false;
+#endif
+}
+
+void UUHLDebugGraphSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Settings = GetDefault<UUHLSettings>()->DebugGraphSettings;
+	bGraphsVisible = Settings.bShowByDefault;
+
+	ConfigureMetric(FrameTimeMetricName, FLinearColor::Green, EUHLDebugGraphStyle::Bars, 0.0f, 1000.0f / 60.0f);
+
+	DrawDelegateHandle = UDebugDrawService::Register(TEXT("Game"), FDebugDrawDelegate::CreateUObject(this, &UUHLDebugGraphSubsystem::Draw));
+}
+
+void UUHLDebugGraphSubsystem::Deinitialize()
+{
+	UDebugDrawService::Unregister(DrawDelegateHandle);
+	Metrics.Empty();
+	MetricIndexByName.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UUHLDebugGraphSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UUHLDebugGraphSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UUHLDebugGraphSubsystem, STATGROUP_Tickables);
+}
+
+void UUHLDebugGraphSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Settings.bRecordFrameTime)
+	{
+		// real frame time, not affected by time dilation
+		PushValue(FrameTimeMetricName, FApp::GetDeltaTime() * 1000.0f);
+	}
+}
+
+void UUHLDebugGraphSubsystem::PushValueToWorld(const UObject* WorldContextObject, FName MetricName, float Value)
+{
+	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	if (UUHLDebugGraphSubsystem* DebugGraphSubsystem = World ? World->GetSubsystem<UUHLDebugGraphSubsystem>() : nullptr)
+	{
+		DebugGraphSubsystem->PushValue(MetricName, Value);
+	}
+}
+
+void UUHLDebugGraphSubsystem::PushValue(FName MetricName, float Value)
+{
+	FMetric& Metric = FindOrAddMetric(MetricName);
+	Metric.Samples[Metric.Head] = Value;
+	Metric.Head = (Metric.Head + 1) % Metric.Samples.Num();
+	Metric.NumValidSamples = FMath::Min(Metric.NumValidSamples + 1, Metric.Samples.Num());
+	Metric.LastValue = Value;
+
+	OnValuePushed.Broadcast(MetricName, Value);
+}
+
+void UUHLDebugGraphSubsystem::ConfigureMetric(FName MetricName, FLinearColor Color, EUHLDebugGraphStyle Style, float MaxValue, float Threshold)
+{
+	FMetric& Metric = FindOrAddMetric(MetricName);
+	Metric.Color = Color;
+	Metric.Style = Style;
+	Metric.MaxValue = MaxValue;
+	Metric.Threshold = Threshold;
+}
+
+void UUHLDebugGraphSubsystem::RemoveMetric(FName MetricName)
+{
+	int32 Index = INDEX_NONE;
+	if (!MetricIndexByName.RemoveAndCopyValue(MetricName, Index))
+	{
+		return;
+	}
+
+	Metrics.RemoveAt(Index);
+	for (TPair<FName, int32>& MetricIndex : MetricIndexByName)
+	{
+		if (MetricIndex.Value > Index)
+		{
+			MetricIndex.Value--;
+		}
+	}
+}
+
+bool UUHLDebugGraphSubsystem::AreGraphsVisible() const
+{
+	const int32 CVarValue = CVarUHLDebugGraph.GetValueOnGameThread();
+	return CVarValue < 0 ? bGraphsVisible : CVarValue > 0;
+}
+
+UUHLDebugGraphSubsystem::FMetric& UUHLDebugGraphSubsystem::FindOrAddMetric(FName MetricName)
+{
+	if (const int32* Index = MetricIndexByName.Find(MetricName))
+	{
+		return Metrics[*Index];
+	}
+
+	FMetric& Metric = Metrics.AddDefaulted_GetRef();
+	Metric.Name = MetricName;
+	Metric.Samples.SetNumZeroed(Settings.NumSamples);
+	MetricIndexByName.Add(MetricName, Metrics.Num() - 1);
+	return Metric;
+}
+
+void UUHLDebugGraphSubsystem::Draw(UCanvas* Canvas, APlayerController* PlayerController)
+{
+	// draw service isn't per world, skip other PIE instances
+	if (!Canvas || !AreGraphsVisible() || (PlayerController && PlayerController->GetWorld() != GetWorld()))
+	{
+		return;
+	}
+
+	TriangleItem.TriangleList.Reset();
+
+	const FVector2D GraphSize = Settings.GraphSize;
+	FVector2D GraphMin = Settings.Position;
+	for (const FMetric& Metric : Metrics)
+	{
+		if (Metric.NumValidSamples == 0)
+		{
+			continue;
+		}
+
+		const FVector2D GraphMax = GraphMin + GraphSize;
+		AddQuad(GraphMin, GraphMax, Settings.BackgroundColor);
+
+		const int32 NumSamples = Metric.Samples.Num();
+		const int32 FirstSample = (Metric.Head - Metric.NumValidSamples + NumSamples) % NumSamples;
+
+		float MaxValue = Metric.MaxValue;
+		if (MaxValue <= 0.0f)
+		{
+			for (int32 i = 0; i < Metric.NumValidSamples; i++)
+			{
+				MaxValue = FMath::Max(MaxValue, Metric.Samples[(FirstSample + i) % NumSamples]);
+			}
+			MaxValue = FMath::Max(MaxValue, Metric.Threshold);
+		}
+		MaxValue = FMath::Max(MaxValue, UE_KINDA_SMALL_NUMBER);
+
+		// newest sample on the right, graph is filled from right to left
+		const float SampleWidth = GraphSize.X / NumSamples;
+		const float StartX = GraphMax.X - SampleWidth * Metric.NumValidSamples;
+		FVector2D PrevPoint;
+		for (int32 i = 0; i < Metric.NumValidSamples; i++)
+		{
+			const float Value = Metric.Samples[(FirstSample + i) % NumSamples];
+			const float Height = FMath::Clamp(Value / MaxValue, 0.0f, 1.0f) * GraphSize.Y;
+			const float X = StartX + SampleWidth * i;
+
+			if (Metric.Style == EUHLDebugGraphStyle::Bars)
+			{
+				AddQuad(FVector2D(X, GraphMax.Y - Height), FVector2D(X + FMath::Max(SampleWidth - 1.0f, 1.0f), GraphMax.Y), Metric.Color);
+			}
+			else
+			{
+				const FVector2D Point(X + SampleWidth * 0.5f, GraphMax.Y - Height);
+				if (i > 0)
+				{
+					AddSegment(PrevPoint, Point, 1.5f, Metric.Color);
+				}
+				PrevPoint = Point;
+			}
+		}
+
+		if (Metric.Threshold > 0.0f && Metric.Threshold <= MaxValue)
+		{
+			const float ThresholdY = GraphMax.Y - Metric.Threshold / MaxValue * GraphSize.Y;
+			AddSegment(FVector2D(GraphMin.X, ThresholdY), FVector2D(GraphMax.X, ThresholdY), 1.0f, FLinearColor::Red);
+		}
+
+		GraphMin.Y += GraphSize.Y + Settings.GraphSpacing;
+	}
+
+	if (TriangleItem.TriangleList.IsEmpty())
+	{
+		return;
+	}
+
+	TriangleItem.Texture = GWhiteTexture;
+	TriangleItem.BlendMode = SE_BLEND_Translucent;
+	Canvas->DrawItem(TriangleItem);
+
+	// labels after graphs, so they aren't covered by bars
+	UFont* Font = GEngine->GetTinyFont();
+	FVector2D LabelPosition = Settings.Position;
+	for (const FMetric& Metric : Metrics)
+	{
+		if (Metric.NumValidSamples == 0)
+		{
+			continue;
+		}
+
+		Canvas->SetDrawColor(FColor::White);
+		Canvas->DrawText(Font, FString::Printf(TEXT("%s: %.2f"), *Metric.Name.ToString(), Metric.LastValue), LabelPosition.X + 2.0f, LabelPosition.Y + 2.0f);
+		LabelPosition.Y += GraphSize.Y + Settings.GraphSpacing;
+	}
+}
+
+void UUHLDebugGraphSubsystem::AddQuad(const FVector2D& Min, const FVector2D& Max, const FLinearColor& Color)
+{
+	FCanvasUVTri& First = TriangleItem.TriangleList.AddDefaulted_GetRef();
+	First.V0_Pos = Min;
+	First.V1_Pos = FVector2D(Max.X, Min.Y);
+	First.V2_Pos = Max;
+	First.V0_Color = First.V1_Color = First.V2_Color = Color;
+
+	FCanvasUVTri& Second = TriangleItem.TriangleList.AddDefaulted_GetRef();
+	Second.V0_Pos = Min;
+	Second.V1_Pos = Max;
+	Second.V2_Pos = FVector2D(Min.X, Max.Y);
+	Second.V0_Color = Second.V1_Color = Second.V2_Color = Color;
+}
+
+void UUHLDebugGraphSubsystem::AddSegment(const FVector2D& Start, const FVector2D& End, float Thickness, const FLinearColor& Color)
+{
+	const FVector2D Direction = (End - Start).GetSafeNormal();
+	const FVector2D Offset = FVector2D(-Direction.Y, Direction.X) * (Thickness * 0.5f);
+
+	FCanvasUVTri& First = TriangleItem.TriangleList.AddDefaulted_GetRef();
+	First.V0_Pos = Start - Offset;
+	First.V1_Pos = End - Offset;
+	First.V2_Pos = End + Offset;
+	First.V0_Color = First.V1_Color = First.V2_Color = Color;
+
+	FCanvasUVTri& Second = TriangleItem.TriangleList.AddDefaulted_GetRef();
+	Second.V0_Pos = Start - Offset;
+	Second.V1_Pos = End + Offset;
+	Second.V2_Pos = Start + Offset;
+	Second.V0_Color = Second.V1_Color = Second.V2_Color = Color;
+}
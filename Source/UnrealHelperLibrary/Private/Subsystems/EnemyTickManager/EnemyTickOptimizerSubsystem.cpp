@@ -3,38 +3,117 @@
 
 #include "Subsystems/EnemyTickManager/EnemyTickOptimizerSubsystem.h"
 
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Components/UHLTickSmoothingComponent.h"
 #include "GameFramework/Character.h"
 #include "Development/UHLSettings.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
+#include "Misc/ScopeExit.h"
+#include "Subsystems/DebugGraph/UHLDebugGraphSubsystem.h"
 
 void UEnemyTickOptimizerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
 	const UUHLSettings* UHLSettings = GetDefault<UUHLSettings>();
-	Settings = UHLSettings->EnemyTickOptimizerSubsystemSettings;
+	ApplySettings(UHLSettings->GetEnemyTickOptimizerSettings(Scalability::GetQualityLevels()));
 
+	ScalabilityChangedHandle = Scalability::OnScalabilitySettingsChanged.AddUObject(this, &UEnemyTickOptimizerSubsystem::OnScalabilitySettingsChanged);
+}
+
+void UEnemyTickOptimizerSubsystem::Deinitialize()
+{
+	Scalability::OnScalabilitySettingsChanged.Remove(ScalabilityChangedHandle);
+
+	// Clear the timer when the subsystem is shut down
+	GetWorld()->GetTimerManager().ClearTimer(TickOptimizerTimerHandle);
+	SpatialIndex.Reset();
+	AnimationSharing.Reset();
+	SharedAnimations.Reset();
+	TickBatcher.Reset();
+	CostTracker.Reset();
+	EnemyStates.Reset();
+	TierChangedDelegates.Reset();
+	
+	Super::Deinitialize();
+}
+
+void UEnemyTickOptimizerSubsystem::ApplySettings(const FEnemyTickOptimizerSubsystemSettings& NewSettings)
+{
+	for (ACharacter* Enemy : RegisteredEnemies)
+	{
+		RestoreEnemyState(Enemy);
+	}
+
+	Settings = NewSettings;
+
+	if (Settings.AnimSharingSettings.bEnableAnimationSharing)
+	{
+		AnimationSharing.SetSettings(Settings.AnimSharingSettings);
+		AnimationSharing.GetAnimations(SharedAnimations);
+	}
+	else
+	{
+		AnimationSharing.Reset();
+		SharedAnimations.Reset();
+	}
+	TickBatcher.Reset();
+	TickBatcher.bBatchSkeletalMeshes = Settings.bBatchSkeletalMeshes;
+
+	// measured costs stay valid when only other settings change
+	if (Settings.CostSettings.bMeasureTickCost)
+	{
+		CostTracker.SetSettings(Settings.CostSettings);
+		TickBatcher.CostTracker = &CostTracker;
+	}
+	else
+	{
+		CostTracker.Reset();
+		TickBatcher.CostTracker = nullptr;
+	}
+
+	SpatialIndex.SetCellSize(Settings.SpatialIndexCellSize);
+	if (Settings.bEnableSpatialIndex)
+	{
+		for (ACharacter* Enemy : RegisteredEnemies)
+		{
+			if (Enemy && !SpatialIndex.Contains(Enemy))
+			{
+				SpatialIndex.Add(Enemy);
+			}
+		}
+	}
+	else
+	{
+		SpatialIndex.Reset();
+	}
+	SpatialIndexRefreshTime = -1.0;
+
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	TimerManager.ClearTimer(TickOptimizerTimerHandle);
 	if (Settings.bEnable)
 	{
-		// Set up a timer to call UpdateTickIntervals every 0.5 seconds
-		GetWorld()->GetTimerManager().SetTimer(
+		// Set up a timer to call UpdateTickIntervals every UpdateInterval seconds
+		TimerManager.SetTimer(
 			TickOptimizerTimerHandle,
 			this,
 			&UEnemyTickOptimizerSubsystem::UpdateTickIntervals,
 			Settings.UpdateInterval,
 			true
-		);	
+		);
 	}
 }
 
-void UEnemyTickOptimizerSubsystem::Deinitialize()
+void UEnemyTickOptimizerSubsystem::OnScalabilitySettingsChanged(const Scalability::FQualityLevels& QualityLevels)
 {
-	// Clear the timer when the subsystem is shut down
-	GetWorld()->GetTimerManager().ClearTimer(TickOptimizerTimerHandle);
-	
-	Super::Deinitialize();
+	const FEnemyTickOptimizerSubsystemSettings& NewSettings = GetDefault<UUHLSettings>()->GetEnemyTickOptimizerSettings(QualityLevels);
+	if (!FEnemyTickOptimizerSubsystemSettings::StaticStruct()->CompareScriptStruct(&Settings, &NewSettings, PPF_None))
+	{
+		ApplySettings(NewSettings);
+	}
 }
 
 void UEnemyTickOptimizerSubsystem::RegisterEnemy(ACharacter* Enemy)
@@ -42,16 +121,78 @@ void UEnemyTickOptimizerSubsystem::RegisterEnemy(ACharacter* Enemy)
 	if (Enemy && !RegisteredEnemies.Contains(Enemy))
 	{
 		RegisteredEnemies.Add(Enemy);
+
+		if (Settings.bEnableSpatialIndex)
+		{
+			SpatialIndex.Add(Enemy);
+		}
 	}
 }
 
 void UEnemyTickOptimizerSubsystem::UnregisterEnemy(ACharacter* Enemy)
 {
 	RegisteredEnemies.Remove(Enemy);
+	SpatialIndex.Remove(Enemy);
+	CostTracker.RemoveInstance(Enemy);
+	RestoreEnemyState(Enemy);
+}
+
+void UEnemyTickOptimizerSubsystem::QueryEnemiesInRadius(FVector Center, float Radius, TArray<ACharacter*>& OutEnemies)
+{
+	GetSpatialIndex().QueryRadius(Center, Radius, OutEnemies);
+}
+
+void UEnemyTickOptimizerSubsystem::QueryNearestEnemies(FVector Center, int32 Count, float MaxRadius, TArray<ACharacter*>& OutEnemies)
+{
+	GetSpatialIndex().QueryKNearest(Center, Count, MaxRadius, OutEnemies);
+}
+
+void UEnemyTickOptimizerSubsystem::QueryEnemiesInCone(FVector Origin, FVector Direction, float HalfAngleDegrees, float Range, TArray<ACharacter*>& OutEnemies)
+{
+	GetSpatialIndex().QueryCone(Origin, Direction, HalfAngleDegrees, Range, OutEnemies);
+}
+
+void UEnemyTickOptimizerSubsystem::QueryEnemiesInBox(FBox Box, TArray<ACharacter*>& OutEnemies)
+{
+	GetSpatialIndex().QueryBox(Box, OutEnemies);
+}
+
+const FUHLEnemySpatialIndex& UEnemyTickOptimizerSubsystem::GetSpatialIndex()
+{
+	RefreshSpatialIndexIfStale();
+	return SpatialIndex;
+}
+
+void UEnemyTickOptimizerSubsystem::RefreshSpatialIndexIfStale()
+{
+	if (!Settings.bEnableSpatialIndex || SpatialIndexRefreshFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	const UWorld* World = GetWorld();
+	const double CurrentTime = World ? World->GetTimeSeconds() : 0.0;
+	if (SpatialIndexRefreshTime >= 0.0 && CurrentTime - SpatialIndexRefreshTime < Settings.SpatialIndexMaxAge)
+	{
+		return;
+	}
+
+	SpatialIndex.UpdateAll();
+	SpatialIndexRefreshFrame = GFrameCounter;
+	SpatialIndexRefreshTime = CurrentTime;
 }
 
 void UEnemyTickOptimizerSubsystem::UpdateTickIntervals()
 {
+#if UHL_DEBUG_GRAPH_ENABLED
+	const double UpdateStartTime = FPlatformTime::Seconds();
+	ON_SCOPE_EXIT
+	{
+		UHL_DEBUG_GRAPH_PUSH(this, TEXT("EnemyTickOptimizerMs"), (FPlatformTime::Seconds() - UpdateStartTime) * 1000.0);
+	};
+	PushCostsToDebugGraph();
+#endif
+
 	// Get the player character
 	ACharacter* PlayerCharacter = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
 	if (!PlayerCharacter)
@@ -66,52 +207,292 @@ void UEnemyTickOptimizerSubsystem::UpdateTickIntervals()
 	{
 		if (Enemy)
 		{
-			float Distance = FVector::Dist(PlayerLocation, Enemy->GetActorLocation());
-			float TickInterval;
-
-			if (Distance < Settings.CloseDistance)
+			const FVector EnemyLocation = Enemy->GetActorLocation();
+			float Distance = FVector::Dist(PlayerLocation, EnemyLocation);
+			// without batching there are no samples, weighting would only use stale costs
+			if (Settings.CostSettings.bWeightTiersByCost && Settings.bBatchTicks)
 			{
-				TickInterval = Settings.CloseTickInterval; // e.g., 0.0f (every frame)
+				Distance *= GetCostDistanceScale(Enemy);
 			}
-			else if (Distance < Settings.MediumDistance)
+
+			// location already read, keep index fresh for free
+			if (Settings.bEnableSpatialIndex)
 			{
-				TickInterval = Settings.MediumTickInterval; // e.g., 0.1f
+				SpatialIndex.Update(Enemy, EnemyLocation);
 			}
-			else if (Distance < Settings.FarDistance)
+
+			const EEnemyTickOptimizerTier Tier = CalculateTier(Enemy, Distance);
+			const float TickInterval = GetTierTickInterval(Tier);
+
+			FEnemyTickOptimizerEnemyState& EnemyState = EnemyStates.FindOrAdd(Enemy);
+			if (EnemyState.Tier != Tier)
 			{
-				TickInterval = Settings.FarTickInterval; // e.g., 0.5f
+				OnEnemyTierChanged(Enemy, EnemyState, Tier);
 			}
-			else
+			else if (AnimationSharing.IsShared(Enemy))
 			{
-				TickInterval = Settings.DefaultEnemyTickInterval; // e.g., 1.0f
+				AnimationSharing.UpdateEnemy(Enemy);
 			}
 
-			if (Settings.bDontTickIfNotRenderedRecently 
-				&& !Enemy->WasRecentlyRendered()
-				&& Distance > Settings.MediumDistance)
-			{
-				TickInterval = Settings.RecentlyNotRenderedTickInterval;
-			}
+			// batched enemy ticked by batch with its own interval, native tick functions are disabled
+			const bool bBatched = TickBatcher.Contains(Enemy);
 
 			// Set tick interval for the enemy actor
-			Enemy->SetActorTickInterval(TickInterval);
+			if (!bBatched)
+			{
+				Enemy->SetActorTickInterval(TickInterval);
+			}
 			// Enemy->GetMesh()->SetComponentTickInterval(TickInterval);
 			if (Settings.bSetTickOnActorComponentsAlso)
 			{
 				for (UActorComponent* Component : Enemy->GetComponents())
 				{
-					if (Component->IsComponentTickEnabled())
+					// smoothing has to run every frame to hide reduced tick rate
+					if (Component->IsComponentTickEnabled() && !Component->IsA<UUHLTickSmoothingComponent>())
 					{
-						Component->SetComponentTickInterval(TickInterval);
+						// ASC may be throttled harder than the rest of components
+						const bool bThrottledASC = EnemyState.bAbilitySystemThrottled && Component->IsA<UAbilitySystemComponent>();
+						Component->SetComponentTickInterval(bThrottledASC ? Settings.GASSettings.AbilitySystemTickInterval : TickInterval);
 					}
 				}	
 			}
+			else if (EnemyState.bAbilitySystemThrottled)
+			{
+				if (UAbilitySystemComponent* AbilitySystemComponent = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Enemy))
+				{
+					AbilitySystemComponent->SetComponentTickInterval(Settings.GASSettings.AbilitySystemTickInterval);
+				}
+			}
 
 			// Set tick interval for the enemy's controller, if it exists
-			if (AController* Controller = Enemy->GetController())
+			AController* Controller = Enemy->GetController();
+			if (Controller && !bBatched)
 			{
 				Controller->PrimaryActorTick.TickInterval = TickInterval;
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+
+EEnemyTickOptimizerTier UEnemyTickOptimizerSubsystem::GetEnemyTier(const ACharacter* Enemy) const
+{
+	const FEnemyTickOptimizerEnemyState* EnemyState = EnemyStates.Find(Enemy);
+	return EnemyState ? EnemyState->Tier : EEnemyTickOptimizerTier::None;
+}
+
+void UEnemyTickOptimizerSubsystem::GetEnemyClassCosts(TArray<FEnemyTickOptimizerClassCost>& OutCosts) const
+{
+	OutCosts.Reset(CostTracker.GetClassCosts().Num());
+	for (const TPair<TObjectKey<UClass>, FUHLEnemyCost>& ClassCost : CostTracker.GetClassCosts())
+	{
+		UClass* EnemyClass = ClassCost.Key.ResolveObjectPtr();
+		if (!EnemyClass)
+		{
+			continue;
+		}
+
+		FEnemyTickOptimizerClassCost& Cost = OutCosts.AddDefaulted_GetRef();
+		Cost.EnemyClass = EnemyClass;
+		Cost.TickMs = ClassCost.Value.TickMs;
+		Cost.AnimMs = ClassCost.Value.AnimMs;
+		Cost.Samples = ClassCost.Value.Samples;
+		Cost.RelativeCost = CostTracker.GetRelativeCost(EnemyClass);
+	}
+	OutCosts.Sort([](const FEnemyTickOptimizerClassCost& A, const FEnemyTickOptimizerClassCost& B)
+	{
+		return A.TickMs + A.AnimMs > B.TickMs + B.AnimMs;
+	});
+}
+
+float UEnemyTickOptimizerSubsystem::GetEnemyTickCostMs(const ACharacter* Enemy) const
+{
+	const FUHLEnemyCost* Cost = CostTracker.FindCost(Enemy);
+	return Cost ? Cost->GetTotalMs() : -1.0f;
+}
+
+float UEnemyTickOptimizerSubsystem::GetCostDistanceScale(const ACharacter* Enemy) const
+{
+	const FEnemyTickOptimizerCostSettings& CostSettings = Settings.CostSettings;
+	const float Scale = FMath::Pow(CostTracker.GetRelativeCost(Enemy->GetClass()), CostSettings.CostInfluence);
+	return FMath::Clamp(Scale, CostSettings.MinDistanceScale, CostSettings.MaxDistanceScale);
+}
+
+void UEnemyTickOptimizerSubsystem::PushCostsToDebugGraph() const
+{
+#if UHL_DEBUG_GRAPH_ENABLED
+	if (!Settings.CostSettings.bMeasureTickCost || CostTracker.GetAverageCost().Samples == 0)
+	{
+		return;
+	}
+
+	// recorded by UUHLPerfCaptureSubsystem too, so per-class costs land in capture summary
+	UHL_DEBUG_GRAPH_PUSH(this, TEXT("EnemyTickCostMs"), CostTracker.GetAverageCost().GetTotalMs());
+	for (const TPair<TObjectKey<UClass>, FUHLEnemyCost>& ClassCost : CostTracker.GetClassCosts())
+	{
+		UHL_DEBUG_GRAPH_PUSH(this, ClassCost.Value.DebugGraphMetricName, ClassCost.Value.GetTotalMs());
+	}
+#endif
+}
+
+bool UEnemyTickOptimizerSubsystem::IsAbilitySystemThrottled(const AActor* Actor) const
+{
+	const FEnemyTickOptimizerEnemyState* EnemyState = EnemyStates.Find(Cast<ACharacter>(Actor));
+	return EnemyState && EnemyState->bAbilitySystemThrottled;
+}
+
+bool UEnemyTickOptimizerSubsystem::ShouldSuppressGameplayCue(const AActor* TargetActor, const FGameplayTag& GameplayCueTag) const
+{
+	if (!Settings.GASSettings.bSuppressNonCriticalGameplayCues || !IsAbilitySystemThrottled(TargetActor))
+	{
+		return false;
+	}
+	return !GameplayCueTag.MatchesAny(Settings.GASSettings.CriticalGameplayCueTags);
+}
+
+EEnemyTickOptimizerTier UEnemyTickOptimizerSubsystem::CalculateTier(const ACharacter* Enemy, float Distance) const
+{
+	if (Settings.bDontTickIfNotRenderedRecently 
+		&& !Enemy->WasRecentlyRendered()
+		&& Distance > Settings.MediumDistance)
+	{
+		return EEnemyTickOptimizerTier::NotRendered;
+	}
+
+	if (Distance < Settings.CloseDistance)
+	{
+		return EEnemyTickOptimizerTier::Close;
+	}
+	if (Distance < Settings.MediumDistance)
+	{
+		return EEnemyTickOptimizerTier::Medium;
+	}
+	if (Distance < Settings.FarDistance)
+	{
+		return EEnemyTickOptimizerTier::Far;
+	}
+	return EEnemyTickOptimizerTier::OutOfRange;
+}
+
+float UEnemyTickOptimizerSubsystem::GetTierTickInterval(EEnemyTickOptimizerTier Tier) const
+{
+	switch (Tier)
+	{
+		case EEnemyTickOptimizerTier::Close:		return Settings.CloseTickInterval; // e.g., 0.0f (every frame)
+		case EEnemyTickOptimizerTier::Medium:		return Settings.MediumTickInterval; // e.g., 0.1f
+		case EEnemyTickOptimizerTier::Far:			return Settings.FarTickInterval; // e.g., 0.5f
+		case EEnemyTickOptimizerTier::NotRendered:	return Settings.RecentlyNotRenderedTickInterval;
+		default:									return Settings.DefaultEnemyTickInterval; // e.g., 1.0f
+	}
+}
+
+FDelegateHandle UEnemyTickOptimizerSubsystem::AddOnTierChangedHandler(const ACharacter* Enemy, FOnEnemyTickOptimizerTierChanged::FDelegate&& Delegate)
+{
+	return TierChangedDelegates.FindOrAdd(Enemy).Add(MoveTemp(Delegate));
+}
+
+void UEnemyTickOptimizerSubsystem::RemoveOnTierChangedHandler(const ACharacter* Enemy, FDelegateHandle Handle)
+{
+	if (FOnEnemyTickOptimizerTierChanged* TierChangedDelegate = TierChangedDelegates.Find(Enemy))
+	{
+		// entry kept, handler can be removed during broadcast
+		TierChangedDelegate->Remove(Handle);
+	}
+}
+
+void UEnemyTickOptimizerSubsystem::OnEnemyTierChanged(ACharacter* Enemy, FEnemyTickOptimizerEnemyState& EnemyState, EEnemyTickOptimizerTier NewTier)
+{
+	const EEnemyTickOptimizerTier OldTier = EnemyState.Tier;
+	EnemyState.Tier = NewTier;
+
+	if (const FOnEnemyTickOptimizerTierChanged* TierChangedDelegate = TierChangedDelegates.Find(Enemy))
+	{
+		TierChangedDelegate->Broadcast(Enemy, OldTier, NewTier);
+	}
+
+	const FEnemyTickOptimizerAnimSharingSettings& AnimSharingSettings = Settings.AnimSharingSettings;
+	if (AnimSharingSettings.bEnableAnimationSharing)
+	{
+		if (NewTier >= AnimSharingSettings.MinSharedTier)
+		{
+			AnimationSharing.ShareEnemy(Enemy);
+		}
+		else
+		{
+			AnimationSharing.UnshareEnemy(Enemy);
+		}
+	}
+
+	if (Settings.bBatchTicks)
+	{
+		if (NewTier >= Settings.MinBatchedTier)
+		{
+			TickBatcher.AddEnemy(Enemy, static_cast<int32>(NewTier), GetTierTickInterval(NewTier));
+		}
+		else
+		{
+			TickBatcher.RemoveEnemy(Enemy);
+		}
+	}
+
+	const FEnemyTickOptimizerGASSettings& GASSettings = Settings.GASSettings;
+	const bool bShouldThrottleASC = GASSettings.bThrottleAbilitySystem && NewTier >= GASSettings.MinThrottledTier;
+	if (bShouldThrottleASC == EnemyState.bAbilitySystemThrottled)
+	{
+		return;
+	}
+
+	EnemyState.bAbilitySystemThrottled = bShouldThrottleASC;
+
+	UAbilitySystemComponent* AbilitySystemComponent = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Enemy);
+	if (!AbilitySystemComponent)
+	{
+		return;
+	}
+
+	if (GASSettings.bSuppressAllGameplayCues)
+	{
+		if (bShouldThrottleASC)
+		{
+			EnemyState.bInitialSuppressGameplayCues = AbilitySystemComponent->bSuppressGameplayCues;
+			AbilitySystemComponent->bSuppressGameplayCues = true;
+		}
+		else
+		{
+			AbilitySystemComponent->bSuppressGameplayCues = EnemyState.bInitialSuppressGameplayCues;
+		}
+	}
+
+	// on promotion give ASC its regular rate right away, don't wait for next update
+	if (!bShouldThrottleASC)
+	{
+		AbilitySystemComponent->SetComponentTickInterval(GetTierTickInterval(NewTier));
+	}
+}
+
+void UEnemyTickOptimizerSubsystem::RestoreEnemyState(ACharacter* Enemy)
+{
+	AnimationSharing.UnshareEnemy(Enemy);
+	TickBatcher.RemoveEnemy(Enemy);
+
+	FEnemyTickOptimizerEnemyState EnemyState;
+	if (!EnemyStates.RemoveAndCopyValue(Enemy, EnemyState) || !IsValid(Enemy))
+	{
+		return;
+	}
+
+	if (!EnemyState.bAbilitySystemThrottled)
+	{
+		return;
+	}
+
+	if (UAbilitySystemComponent* AbilitySystemComponent = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Enemy))
+	{
+		if (Settings.GASSettings.bSuppressAllGameplayCues)
+		{
+			AbilitySystemComponent->bSuppressGameplayCues = EnemyState.bInitialSuppressGameplayCues;
+		}
+		// UpdateTickIntervals won't touch ASC again if new settings don't throttle it
+		// and bSetTickOnActorComponentsAlso is off, give it regular interval of its tier
+		AbilitySystemComponent->SetComponentTickInterval(GetTierTickInterval(EnemyState.Tier));
+	}
+}
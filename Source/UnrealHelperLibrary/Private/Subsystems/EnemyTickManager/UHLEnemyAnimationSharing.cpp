@@ -0,0 +1,240 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Subsystems/EnemyTickManager/UHLEnemyAnimationSharing.h"
+
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimSequenceBase.h"
+#include "Animation/SkeletalMeshActor.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "Subsystems/EnemyTickManager/EnemyTickOptimizerSubsystem.h"
+
+void FUHLEnemyAnimationSharing::SetSettings(const FEnemyTickOptimizerAnimSharingSettings& InSettings)
+{
+	Reset();
+
+	DriversPerState = FMath::Max(InSettings.DriversPerState, 1);
+	States.Reset();
+	for (const FEnemyTickOptimizerSharedAnimState& State : InSettings.States)
+	{
+		// loaded once here, drivers created on demand later
+		if (UAnimSequenceBase* Animation = State.Animation.LoadSynchronous())
+		{
+			States.Add({ State.MinSpeed, Animation });
+		}
+	}
+	States.Sort([](const FState& A, const FState& B) { return A.MinSpeed < B.MinSpeed; });
+}
+
+void FUHLEnemyAnimationSharing::GetAnimations(TArray<TObjectPtr<UAnimSequenceBase>>& OutAnimations) const
+{
+	OutAnimations.Reset(States.Num());
+	for (const FState& State : States)
+	{
+		OutAnimations.Add(State.Animation.Get());
+	}
+}
+
+void FUHLEnemyAnimationSharing::Reset()
+{
+	TArray<TObjectKey<ACharacter>> Enemies;
+	SharedEnemies.GetKeys(Enemies);
+	for (const TObjectKey<ACharacter>& Enemy : Enemies)
+	{
+		UnshareEnemy(Enemy.ResolveObjectPtr());
+	}
+	SharedEnemies.Reset();
+
+	for (const TPair<FDriverKey, TArray<TWeakObjectPtr<USkeletalMeshComponent>>>& StateDrivers : Drivers)
+	{
+		for (const TWeakObjectPtr<USkeletalMeshComponent>& Driver : StateDrivers.Value)
+		{
+			if (AActor* DriverActor = Driver.IsValid() ? Driver->GetOwner() : nullptr)
+			{
+				DriverActor->Destroy();
+			}
+		}
+	}
+	Drivers.Reset();
+}
+
+int32 FUHLEnemyAnimationSharing::NumDrivers() const
+{
+	int32 Result = 0;
+	for (const TPair<FDriverKey, TArray<TWeakObjectPtr<USkeletalMeshComponent>>>& StateDrivers : Drivers)
+	{
+		Result += StateDrivers.Value.Num();
+	}
+	return Result;
+}
+
+bool FUHLEnemyAnimationSharing::ShareEnemy(ACharacter* Enemy)
+{
+	if (!IsValid(Enemy) || States.IsEmpty() || IsShared(Enemy))
+	{
+		return false;
+	}
+
+	USkeletalMeshComponent* Mesh = Enemy->GetMesh();
+	USkeletalMesh* SkeletalMesh = Mesh ? Mesh->GetSkeletalMeshAsset() : nullptr;
+	if (!SkeletalMesh || Mesh->LeaderPoseComponent.IsValid())
+	{
+		return false;
+	}
+	const UAnimInstance* AnimInstance = Mesh->GetAnimInstance();
+	if (AnimInstance && AnimInstance->IsAnyMontagePlaying())
+	{
+		return false;
+	}
+
+	const int32 StateIndex = GetStateIndex(Enemy);
+	USkeletalMeshComponent* Driver = GetOrCreateDriver(Enemy, SkeletalMesh, StateIndex);
+	if (!Driver)
+	{
+		return false;
+	}
+
+	FSharedEnemy& SharedEnemy = SharedEnemies.Add(Enemy);
+	SharedEnemy.Mesh = Mesh;
+	SharedEnemy.StateIndex = StateIndex;
+	SharedEnemy.bInitialPauseAnims = Mesh->bPauseAnims;
+	for (const TWeakObjectPtr<USkinnedMeshComponent>& Follower : Mesh->GetFollowerPoseComponents())
+	{
+		if (USkeletalMeshComponent* FollowerMesh = Cast<USkeletalMeshComponent>(Follower.Get()))
+		{
+			SharedEnemy.Followers.Add(FollowerMesh);
+		}
+	}
+
+	Mesh->bPauseAnims = true;
+	SetLeader(SharedEnemy, Driver);
+	return true;
+}
+
+void FUHLEnemyAnimationSharing::UnshareEnemy(ACharacter* Enemy)
+{
+	FSharedEnemy SharedEnemy;
+	if (!SharedEnemies.RemoveAndCopyValue(Enemy, SharedEnemy))
+	{
+		return;
+	}
+
+	USkeletalMeshComponent* Mesh = SharedEnemy.Mesh.Get();
+	if (!Mesh)
+	{
+		return;
+	}
+
+	Mesh->SetLeaderPoseComponent(nullptr);
+	Mesh->bPauseAnims = SharedEnemy.bInitialPauseAnims;
+	for (const TWeakObjectPtr<USkeletalMeshComponent>& Follower : SharedEnemy.Followers)
+	{
+		if (Follower.IsValid())
+		{
+			Follower->SetLeaderPoseComponent(Mesh);
+		}
+	}
+}
+
+void FUHLEnemyAnimationSharing::UpdateEnemy(ACharacter* Enemy)
+{
+	FSharedEnemy* SharedEnemy = SharedEnemies.Find(Enemy);
+	USkeletalMeshComponent* Mesh = SharedEnemy ? SharedEnemy->Mesh.Get() : nullptr;
+	if (!Mesh)
+	{
+		return;
+	}
+
+	// montages need own evaluation, e.g. ability started on far enemy
+	const UAnimInstance* AnimInstance = Mesh->GetAnimInstance();
+	if (AnimInstance && AnimInstance->IsAnyMontagePlaying())
+	{
+		UnshareEnemy(Enemy);
+		return;
+	}
+
+	const int32 StateIndex = GetStateIndex(Enemy);
+	if (StateIndex == SharedEnemy->StateIndex)
+	{
+		return;
+	}
+
+	if (USkeletalMeshComponent* Driver = GetOrCreateDriver(Enemy, Mesh->GetSkeletalMeshAsset(), StateIndex))
+	{
+		SharedEnemy->StateIndex = StateIndex;
+		SetLeader(*SharedEnemy, Driver);
+	}
+}
+
+int32 FUHLEnemyAnimationSharing::GetStateIndex(const ACharacter* Enemy) const
+{
+	// sorted by MinSpeed, last matching wins
+	const float Speed = Enemy->GetVelocity().Size2D();
+	int32 Result = 0;
+	for (int32 i = 1; i < States.Num() && Speed >= States[i].MinSpeed; i++)
+	{
+		Result = i;
+	}
+	return Result;
+}
+
+USkeletalMeshComponent* FUHLEnemyAnimationSharing::GetOrCreateDriver(const ACharacter* Enemy, USkeletalMesh* SkeletalMesh, int32 StateIndex)
+{
+	if (!States.IsValidIndex(StateIndex) || !States[StateIndex].Animation.IsValid())
+	{
+		return nullptr;
+	}
+
+	TArray<TWeakObjectPtr<USkeletalMeshComponent>>& StateDrivers = Drivers.FindOrAdd({ SkeletalMesh, StateIndex });
+	StateDrivers.RemoveAll([](const TWeakObjectPtr<USkeletalMeshComponent>& Driver) { return !Driver.IsValid(); });
+
+	// spread enemies between drivers, so crowd isn't perfectly in sync
+	const int32 DriverIndex = GetTypeHash(TObjectKey<ACharacter>(Enemy)) % DriversPerState;
+	if (StateDrivers.IsValidIndex(DriverIndex))
+	{
+		return StateDrivers[DriverIndex].Get();
+	}
+
+	UWorld* World = Enemy->GetWorld();
+	while (StateDrivers.Num() <= DriverIndex)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+		ASkeletalMeshActor* DriverActor = World->SpawnActor<ASkeletalMeshActor>(FVector::ZeroVector, FRotator::ZeroRotator, SpawnParameters);
+		if (!DriverActor)
+		{
+			return nullptr;
+		}
+
+		USkeletalMeshComponent* Driver = DriverActor->GetSkeletalMeshComponent();
+		Driver->SetSkeletalMesh(SkeletalMesh);
+		Driver->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Driver->SetHiddenInGame(true);
+		// hidden leader still has to produce pose for followers
+		Driver->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+		UAnimSequenceBase* Animation = States[StateIndex].Animation.Get();
+		Driver->PlayAnimation(Animation, true);
+		Driver->SetPosition(Animation->GetPlayLength() * StateDrivers.Num() / DriversPerState, false);
+
+		StateDrivers.Add(Driver);
+	}
+	return StateDrivers[DriverIndex].Get();
+}
+
+void FUHLEnemyAnimationSharing::SetLeader(FSharedEnemy& SharedEnemy, USkeletalMeshComponent* Leader) const
+{
+	// leader pose doesn't chain, followers of enemy mesh follow driver directly
+	SharedEnemy.Mesh->SetLeaderPoseComponent(Leader, true);
+	for (const TWeakObjectPtr<USkeletalMeshComponent>& Follower : SharedEnemy.Followers)
+	{
+		if (Follower.IsValid())
+		{
+			Follower->SetLeaderPoseComponent(Leader, true);
+		}
+	}
+}
@@ -0,0 +1,70 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Subsystems/EnemyTickManager/UHLEnemyCostTracker.h"
+
+#include "GameFramework/Character.h"
+#include "Subsystems/EnemyTickManager/EnemyTickOptimizerSubsystem.h"
+
+void FUHLEnemyCost::AddSample(double SampleTickMs, double SampleAnimMs, float Smoothing)
+{
+	// first sample taken as is, so average doesn't start from zero
+	const double Alpha = Samples == 0 ? 1.0 : Smoothing;
+	TickMs += (SampleTickMs - TickMs) * Alpha;
+	AnimMs += (SampleAnimMs - AnimMs) * Alpha;
+	Samples++;
+}
+
+void FUHLEnemyCostTracker::SetSettings(const FEnemyTickOptimizerCostSettings& InSettings)
+{
+	SampleRate = InSettings.SampleRate;
+	Smoothing = InSettings.Smoothing;
+	MinSamples = FMath::Max(InSettings.MinSamples, 1);
+	bTrackInstances = InSettings.bTrackInstances;
+
+	if (!bTrackInstances)
+	{
+		CostByInstance.Reset();
+	}
+}
+
+void FUHLEnemyCostTracker::Reset()
+{
+	AverageCost = FUHLEnemyCost();
+	CostByClass.Reset();
+	CostByInstance.Reset();
+}
+
+void FUHLEnemyCostTracker::AddSample(const ACharacter* Enemy, double TickMs, double AnimMs)
+{
+	AverageCost.AddSample(TickMs, AnimMs, Smoothing);
+	FUHLEnemyCost& ClassCost = CostByClass.FindOrAdd(Enemy->GetClass());
+	if (ClassCost.Samples == 0)
+	{
+		ClassCost.DebugGraphMetricName = FName(*FString::Printf(TEXT("EnemyTickCostMs.%s"), *Enemy->GetClass()->GetName()));
+	}
+	ClassCost.AddSample(TickMs, AnimMs, Smoothing);
+	if (bTrackInstances)
+	{
+		CostByInstance.FindOrAdd(Enemy).AddSample(TickMs, AnimMs, Smoothing);
+	}
+}
+
+float FUHLEnemyCostTracker::GetRelativeCost(const UClass* EnemyClass) const
+{
+	const FUHLEnemyCost* ClassCost = CostByClass.Find(EnemyClass);
+	if (!ClassCost || ClassCost->Samples < MinSamples || AverageCost.GetTotalMs() <= UE_DOUBLE_SMALL_NUMBER)
+	{
+		return 1.0f;
+	}
+	return ClassCost->GetTotalMs() / AverageCost.GetTotalMs();
+}
+
+const FUHLEnemyCost* FUHLEnemyCostTracker::FindCost(const ACharacter* Enemy) const
+{
+	if (const FUHLEnemyCost* InstanceCost = CostByInstance.Find(Enemy))
+	{
+		return InstanceCost;
+	}
+	return Enemy ? CostByClass.Find(Enemy->GetClass()) : nullptr;
+}
@@ -0,0 +1,342 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Subsystems/EnemyTickManager/UHLEnemySpatialIndex.h"
+
+#include "GameFramework/Character.h"
+
+template <typename VisitorType>
+void FUHLEnemySpatialIndex::ForEachEntryInCells(const FVector2D& Min, const FVector2D& Max, VisitorType&& Visitor) const
+{
+	const FIntPoint MinCell = GetCell(FVector(Min, 0.0f));
+	const FIntPoint MaxCell = GetCell(FVector(Max, 0.0f));
+	const int64 NumCellsInRange = static_cast<int64>(MaxCell.X - MinCell.X + 1) * static_cast<int64>(MaxCell.Y - MinCell.Y + 1);
+
+	auto VisitEntries = [&](const TArray<int32>& CellEntries)
+	{
+		for (const int32 EntryIndex : CellEntries)
+		{
+			const FEntry& Entry = Entries[EntryIndex];
+			if (Entry.Enemy.IsValid())
+			{
+				Visitor(Entry);
+			}
+		}
+	};
+
+	// huge query over sparse grid - cheaper to walk occupied cells than all cells in range
+	if (NumCellsInRange > Cells.Num())
+	{
+		for (const TPair<FIntPoint, TArray<int32>>& Cell : Cells)
+		{
+			if (Cell.Key.X >= MinCell.X && Cell.Key.X <= MaxCell.X
+				&& Cell.Key.Y >= MinCell.Y && Cell.Key.Y <= MaxCell.Y)
+			{
+				VisitEntries(Cell.Value);
+			}
+		}
+		return;
+	}
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			if (const TArray<int32>* CellEntries = Cells.Find(FIntPoint(X, Y)))
+			{
+				VisitEntries(*CellEntries);
+			}
+		}
+	}
+}
+
+void FUHLEnemySpatialIndex::SetCellSize(float InCellSize)
+{
+	const float NewCellSize = FMath::Max(InCellSize, 1.0f);
+	if (FMath::IsNearlyEqual(NewCellSize, CellSize))
+	{
+		return;
+	}
+
+	CellSize = NewCellSize;
+
+	// rebucket everything with new cell size
+	Cells.Reset();
+	for (int32 i = 0; i < Entries.Num(); i++)
+	{
+		Entries[i].Cell = GetCell(Entries[i].Location);
+		AddToCell(Entries[i].Cell, i);
+	}
+}
+
+void FUHLEnemySpatialIndex::Add(ACharacter* Enemy)
+{
+	if (!Enemy || Contains(Enemy))
+	{
+		return;
+	}
+
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Key = TObjectKey<ACharacter>(Enemy);
+	Entry.Enemy = Enemy;
+	Entry.Location = Enemy->GetActorLocation();
+	Entry.Cell = GetCell(Entry.Location);
+
+	const int32 EntryIndex = Entries.Num() - 1;
+	EntryIndexByEnemy.Add(Entry.Key, EntryIndex);
+	AddToCell(Entry.Cell, EntryIndex);
+}
+
+void FUHLEnemySpatialIndex::Remove(const ACharacter* Enemy)
+{
+	if (const int32* EntryIndex = EntryIndexByEnemy.Find(TObjectKey<ACharacter>(Enemy)))
+	{
+		RemoveAt(*EntryIndex);
+	}
+}
+
+void FUHLEnemySpatialIndex::Update(const ACharacter* Enemy, const FVector& Location)
+{
+	const int32* EntryIndex = EntryIndexByEnemy.Find(TObjectKey<ACharacter>(Enemy));
+	if (!EntryIndex)
+	{
+		return;
+	}
+
+	FEntry& Entry = Entries[*EntryIndex];
+	Entry.Location = Location;
+
+	const FIntPoint NewCell = GetCell(Location);
+	if (NewCell != Entry.Cell)
+	{
+		RemoveFromCell(Entry.Cell, *EntryIndex);
+		Entry.Cell = NewCell;
+		AddToCell(NewCell, *EntryIndex);
+	}
+}
+
+void FUHLEnemySpatialIndex::UpdateAll()
+{
+	// backwards because RemoveAt swaps last entry into removed slot
+	for (int32 i = Entries.Num() - 1; i >= 0; i--)
+	{
+		const ACharacter* Enemy = Entries[i].Enemy.Get();
+		if (!IsValid(Enemy))
+		{
+			RemoveAt(i);
+			continue;
+		}
+		Update(Enemy, Enemy->GetActorLocation());
+	}
+}
+
+void FUHLEnemySpatialIndex::Reset()
+{
+	Entries.Reset();
+	EntryIndexByEnemy.Reset();
+	Cells.Reset();
+}
+
+void FUHLEnemySpatialIndex::QueryRadius(const FVector& Center, float Radius, TArray<ACharacter*>& OutEnemies) const
+{
+	OutEnemies.Reset();
+	if (Radius <= 0.0f)
+	{
+		return;
+	}
+
+	const double RadiusSq = FMath::Square(Radius);
+	const FVector2D Center2D(Center);
+	ForEachEntryInCells(Center2D - FVector2D(Radius), Center2D + FVector2D(Radius), [&](const FEntry& Entry)
+	{
+		if (FVector::DistSquared(Entry.Location, Center) <= RadiusSq)
+		{
+			OutEnemies.Add(Entry.Enemy.Get());
+		}
+	});
+}
+
+void FUHLEnemySpatialIndex::QueryKNearest(const FVector& Center, int32 K, float MaxRadius, TArray<ACharacter*>& OutEnemies) const
+{
+	OutEnemies.Reset();
+	ScratchHeap.Reset();
+	if (K <= 0 || Entries.Num() == 0)
+	{
+		return;
+	}
+
+	const FIntPoint CenterCell = GetCell(Center);
+	const double MaxRadiusSq = MaxRadius > 0.0f ? FMath::Square(MaxRadius) : TNumericLimits<double>::Max();
+
+	// farthest ring we ever need to visit
+	int32 MaxRing = 0;
+	if (MaxRadius > 0.0f)
+	{
+		MaxRing = FMath::CeilToInt(MaxRadius / CellSize);
+	}
+	else
+	{
+		for (const TPair<FIntPoint, TArray<int32>>& Cell : Cells)
+		{
+			MaxRing = FMath::Max(MaxRing, FMath::Max(FMath::Abs(Cell.Key.X - CenterCell.X), FMath::Abs(Cell.Key.Y - CenterCell.Y)));
+		}
+	}
+
+	// max-heap by distance, top is the farthest of current K candidates
+	auto FartherFirst = [](const TPair<double, int32>& A, const TPair<double, int32>& B) { return A.Key > B.Key; };
+
+	auto VisitCell = [&](const FIntPoint& CellCoord)
+	{
+		const TArray<int32>* CellEntries = Cells.Find(CellCoord);
+		if (!CellEntries)
+		{
+			return;
+		}
+		for (const int32 EntryIndex : *CellEntries)
+		{
+			const FEntry& Entry = Entries[EntryIndex];
+			if (!Entry.Enemy.IsValid())
+			{
+				continue;
+			}
+			const double DistSq = FVector::DistSquared(Entry.Location, Center);
+			if (DistSq > MaxRadiusSq)
+			{
+				continue;
+			}
+			if (ScratchHeap.Num() < K)
+			{
+				ScratchHeap.HeapPush(TPair<double, int32>(DistSq, EntryIndex), FartherFirst);
+			}
+			else if (DistSq < ScratchHeap.HeapTop().Key)
+			{
+				TPair<double, int32> Farthest;
+				ScratchHeap.HeapPop(Farthest, FartherFirst, EAllowShrinking::No);
+				ScratchHeap.HeapPush(TPair<double, int32>(DistSq, EntryIndex), FartherFirst);
+			}
+		}
+	};
+
+	for (int32 Ring = 0; Ring <= MaxRing; Ring++)
+	{
+		// everything outside of rings visited so far is at least "(Ring - 1) * CellSize" away
+		if (Ring > 0 && ScratchHeap.Num() == K && ScratchHeap.HeapTop().Key <= FMath::Square((Ring - 1) * static_cast<double>(CellSize)))
+		{
+			break;
+		}
+
+		if (Ring == 0)
+		{
+			VisitCell(CenterCell);
+			continue;
+		}
+
+		for (int32 Offset = -Ring; Offset <= Ring; Offset++)
+		{
+			VisitCell(FIntPoint(CenterCell.X + Offset, CenterCell.Y - Ring));
+			VisitCell(FIntPoint(CenterCell.X + Offset, CenterCell.Y + Ring));
+		}
+		for (int32 Offset = -Ring + 1; Offset <= Ring - 1; Offset++)
+		{
+			VisitCell(FIntPoint(CenterCell.X - Ring, CenterCell.Y + Offset));
+			VisitCell(FIntPoint(CenterCell.X + Ring, CenterCell.Y + Offset));
+		}
+	}
+
+	ScratchHeap.Sort([](const TPair<double, int32>& A, const TPair<double, int32>& B) { return A.Key < B.Key; });
+	for (const TPair<double, int32>& Candidate : ScratchHeap)
+	{
+		OutEnemies.Add(Entries[Candidate.Value].Enemy.Get());
+	}
+}
+
+void FUHLEnemySpatialIndex::QueryCone(const FVector& Origin, const FVector& Direction, float HalfAngleDegrees, float Range, TArray<ACharacter*>& OutEnemies) const
+{
+	OutEnemies.Reset();
+	const FVector ConeDirection = Direction.GetSafeNormal();
+	if (Range <= 0.0f || ConeDirection.IsNearlyZero())
+	{
+		return;
+	}
+
+	const double RangeSq = FMath::Square(Range);
+	const double CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(HalfAngleDegrees, 0.0f, 180.0f)));
+	const FVector2D Origin2D(Origin);
+	ForEachEntryInCells(Origin2D - FVector2D(Range), Origin2D + FVector2D(Range), [&](const FEntry& Entry)
+	{
+		const FVector ToEntry = Entry.Location - Origin;
+		const double DistSq = ToEntry.SizeSquared();
+		if (DistSq > RangeSq)
+		{
+			return;
+		}
+		// enemy standing exactly at origin counts as inside
+		if (DistSq <= UE_KINDA_SMALL_NUMBER || FVector::DotProduct(ToEntry, ConeDirection) >= FMath::Sqrt(DistSq) * CosHalfAngle)
+		{
+			OutEnemies.Add(Entry.Enemy.Get());
+		}
+	});
+}
+
+void FUHLEnemySpatialIndex::QueryBox(const FBox& Box, TArray<ACharacter*>& OutEnemies) const
+{
+	OutEnemies.Reset();
+	if (!Box.IsValid)
+	{
+		return;
+	}
+
+	ForEachEntryInCells(FVector2D(Box.Min), FVector2D(Box.Max), [&](const FEntry& Entry)
+	{
+		if (Box.IsInsideOrOn(Entry.Location))
+		{
+			OutEnemies.Add(Entry.Enemy.Get());
+		}
+	});
+}
+
+FIntPoint FUHLEnemySpatialIndex::GetCell(const FVector& Location) const
+{
+	return FIntPoint(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize)
+	);
+}
+
+void FUHLEnemySpatialIndex::AddToCell(const FIntPoint& Cell, int32 EntryIndex)
+{
+	Cells.FindOrAdd(Cell).Add(EntryIndex);
+}
+
+void FUHLEnemySpatialIndex::RemoveFromCell(const FIntPoint& Cell, int32 EntryIndex)
+{
+	if (TArray<int32>* CellEntries = Cells.Find(Cell))
+	{
+		CellEntries->RemoveSingleSwap(EntryIndex, EAllowShrinking::No);
+		// empty cells are kept, enemies usually come back to same places
+	}
+}
+
+void FUHLEnemySpatialIndex::RemoveAt(int32 EntryIndex)
+{
+	RemoveFromCell(Entries[EntryIndex].Cell, EntryIndex);
+	EntryIndexByEnemy.Remove(Entries[EntryIndex].Key);
+
+	const int32 LastIndex = Entries.Num() - 1;
+	if (EntryIndex != LastIndex)
+	{
+		// last entry moves into removed slot - repoint its cell and lookup
+		const FEntry& LastEntry = Entries[LastIndex];
+		if (TArray<int32>* LastCellEntries = Cells.Find(LastEntry.Cell))
+		{
+			const int32 SlotInCell = LastCellEntries->Find(LastIndex);
+			if (SlotInCell != INDEX_NONE)
+			{
+				(*LastCellEntries)[SlotInCell] = EntryIndex;
+			}
+		}
+		EntryIndexByEnemy.FindChecked(LastEntry.Key) = EntryIndex;
+	}
+
+	Entries.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+}
@@ -0,0 +1,303 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Subsystems/EnemyTickManager/UHLEnemyTickBatcher.h"
+
+#include "AbilitySystemComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/UHLTickSmoothingComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/Controller.h"
+#include "Subsystems/EnemyTickManager/UHLEnemyCostTracker.h"
+
+void FUHLEnemyTierTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Batcher)
+	{
+		Batcher->TickBatch(BatchIndex, DeltaTime, TickType);
+	}
+}
+
+FString FUHLEnemyTierTickFunction::DiagnosticMessage()
+{
+	return FString::Printf(TEXT("FUHLEnemyTierTickFunction[%d]"), BatchIndex);
+}
+
+FName FUHLEnemyTierTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName(TEXT("UHLEnemyTierTick"));
+}
+
+FUHLEnemyTickBatcher::~FUHLEnemyTickBatcher()
+{
+	Reset();
+}
+
+void FUHLEnemyTickBatcher::AddEnemy(ACharacter* Enemy, int32 BatchIndex, float TickInterval)
+{
+	if (!IsValid(Enemy) || BatchIndex < 0)
+	{
+		return;
+	}
+
+	const double CurrentTime = Enemy->GetWorld()->GetTimeSeconds();
+
+	FBatchedEnemy BatchedEnemy;
+	if (const FIntPoint* Location = LocationByEnemy.Find(Enemy))
+	{
+		if (Location->X == BatchIndex)
+		{
+			Batches[BatchIndex]->Enemies[Location->Y].TickInterval = TickInterval;
+			return;
+		}
+		// keep last tick time, so next tick gets full delta
+		const FIntPoint PreviousLocation = *Location;
+		LocationByEnemy.Remove(Enemy);
+		BatchedEnemy = TakeFromBatch(PreviousLocation);
+	}
+	else
+	{
+		BatchedEnemy.Key = Enemy;
+		BatchedEnemy.Enemy = Enemy;
+		// continue from native tick, so delta and phase stay same as before batching
+		const float NativeLastTickTime = Enemy->PrimaryActorTick.GetLastTickGameTimeSeconds();
+		BatchedEnemy.LastTickTime = NativeLastTickTime >= 0.0f ? NativeLastTickTime : CurrentTime;
+
+		BatchedEnemy.bActorTick = Enemy->PrimaryActorTick.IsTickFunctionEnabled();
+		Enemy->SetActorTickEnabled(false);
+
+		AController* Controller = Enemy->GetController();
+		if (Controller && Controller->PrimaryActorTick.IsTickFunctionEnabled())
+		{
+			BatchedEnemy.Controller = Controller;
+			Controller->SetActorTickEnabled(false);
+		}
+
+		for (UActorComponent* Component : Enemy->GetComponents())
+		{
+			// ASC stays native, it may be throttled with own interval,
+			// inactive ones too, deactivation while batched releases component
+			if (!Component->IsComponentTickEnabled()
+				|| !Component->IsActive()
+				|| Component->IsA<UUHLTickSmoothingComponent>()
+				|| Component->IsA<UAbilitySystemComponent>()
+				|| (!bBatchSkeletalMeshes && Component->IsA<USkeletalMeshComponent>()))
+			{
+				continue;
+			}
+			BatchedEnemy.Components.Add(Component);
+			Component->SetComponentTickEnabled(false);
+		}
+	}
+
+	// same effective phase native tick would have, enemies entering batch in same frame keep their spread
+	BatchedEnemy.TickInterval = TickInterval;
+	BatchedEnemy.NextTickTime = BatchedEnemy.LastTickTime + TickInterval;
+	if (BatchedEnemy.NextTickTime < CurrentTime)
+	{
+		BatchedEnemy.NextTickTime = CurrentTime;
+	}
+
+	FBatch& Batch = GetOrCreateBatch(BatchIndex, Enemy->GetWorld());
+	LocationByEnemy.Add(Enemy, FIntPoint(BatchIndex, Batch.Enemies.Num()));
+	Batch.Enemies.Add(MoveTemp(BatchedEnemy));
+	Batch.TickFunction.SetTickFunctionEnable(true);
+}
+
+void FUHLEnemyTickBatcher::RemoveEnemy(const ACharacter* Enemy)
+{
+	FIntPoint Location;
+	if (LocationByEnemy.RemoveAndCopyValue(Enemy, Location))
+	{
+		RestoreNativeTicks(TakeFromBatch(Location));
+	}
+}
+
+void FUHLEnemyTickBatcher::Reset()
+{
+	for (TUniquePtr<FBatch>& Batch : Batches)
+	{
+		if (!Batch.IsValid())
+		{
+			continue;
+		}
+		for (const FBatchedEnemy& BatchedEnemy : Batch->Enemies)
+		{
+			RestoreNativeTicks(BatchedEnemy);
+		}
+		if (Batch->TickFunction.IsTickFunctionRegistered())
+		{
+			Batch->TickFunction.UnRegisterTickFunction();
+		}
+	}
+	Batches.Reset();
+	LocationByEnemy.Reset();
+}
+
+void FUHLEnemyTickBatcher::TickBatch(int32 BatchIndex, float DeltaTime, ELevelTick TickType)
+{
+	if (!Batches.IsValidIndex(BatchIndex) || !Batches[BatchIndex].IsValid() || !World.IsValid())
+	{
+		return;
+	}
+
+	const double CurrentTime = World->GetTimeSeconds();
+	TArray<FBatchedEnemy>& Enemies = Batches[BatchIndex]->Enemies;
+	for (int32 i = 0; i < Enemies.Num(); i++)
+	{
+		FBatchedEnemy& BatchedEnemy = Enemies[i];
+		if (CurrentTime < BatchedEnemy.NextTickTime)
+		{
+			continue;
+		}
+
+		ACharacter* Enemy = BatchedEnemy.Enemy.Get();
+		if (!IsValid(Enemy) || Enemy->IsUnreachable())
+		{
+			continue;
+		}
+
+		const float EnemyDeltaTime = CurrentTime - BatchedEnemy.LastTickTime;
+		BatchedEnemy.LastTickTime = CurrentTime;
+		// keep phase, unless fell behind for more than one interval
+		BatchedEnemy.NextTickTime += BatchedEnemy.TickInterval;
+		if (BatchedEnemy.NextTickTime <= CurrentTime)
+		{
+			BatchedEnemy.NextTickTime = CurrentTime + BatchedEnemy.TickInterval;
+		}
+
+		const bool bSampleCost = CostTracker && CostTracker->ShouldSample(BatchedEnemy.TickCount++);
+		const uint64 StartCycles = bSampleCost ? FPlatformTime::Cycles64() : 0;
+		uint64 AnimCycles = 0;
+
+		// same order native prerequisites would give
+		if (AController* Controller = BatchedEnemy.Controller.Get())
+		{
+			// gameplay re-enabled native tick, it ticks natively now
+			if (Controller->PrimaryActorTick.IsTickFunctionEnabled())
+			{
+				BatchedEnemy.Controller.Reset();
+			}
+			else
+			{
+				Controller->TickActor(EnemyDeltaTime * Controller->CustomTimeDilation, TickType, Controller->PrimaryActorTick);
+			}
+		}
+		if (BatchedEnemy.bActorTick)
+		{
+			if (Enemy->PrimaryActorTick.IsTickFunctionEnabled())
+			{
+				BatchedEnemy.bActorTick = false;
+			}
+			else
+			{
+				Enemy->TickActor(EnemyDeltaTime * Enemy->CustomTimeDilation, TickType, Enemy->PrimaryActorTick);
+			}
+		}
+		for (int32 ComponentIndex = 0; ComponentIndex < BatchedEnemy.Components.Num(); ComponentIndex++)
+		{
+			UActorComponent* Component = BatchedEnemy.Components[ComponentIndex].Get();
+			// re-enabled native tick (SetComponentTickEnabled, Activate) or deactivated itself -
+			// released from batch, left in state gameplay put it in
+			if (!Component || Component->IsComponentTickEnabled() || !Component->IsActive())
+			{
+				BatchedEnemy.Components.RemoveAt(ComponentIndex--, 1, EAllowShrinking::No);
+				continue;
+			}
+			const bool bSkeletalMesh = Component->IsA<USkeletalMeshComponent>();
+			const uint64 ComponentStartCycles = bSampleCost && bSkeletalMesh ? FPlatformTime::Cycles64() : 0;
+			// applies owner time dilation and checks registration like native component tick
+			FActorComponentTickFunction::ExecuteTickHelper(Component, false, EnemyDeltaTime, TickType, [Component, TickType, bSkeletalMesh](float DilatedTime)
+			{
+				Component->TickComponent(DilatedTime, TickType, bSkeletalMesh ? nullptr : &Component->PrimaryComponentTick);
+			});
+			if (bSampleCost && bSkeletalMesh)
+			{
+				AnimCycles += FPlatformTime::Cycles64() - ComponentStartCycles;
+			}
+		}
+
+		if (bSampleCost)
+		{
+			const uint64 TotalCycles = FPlatformTime::Cycles64() - StartCycles;
+			CostTracker->AddSample(Enemy, FPlatformTime::ToMilliseconds64(TotalCycles - AnimCycles), FPlatformTime::ToMilliseconds64(AnimCycles));
+		}
+	}
+}
+
+FUHLEnemyTickBatcher::FBatch& FUHLEnemyTickBatcher::GetOrCreateBatch(int32 BatchIndex, UWorld* InWorld)
+{
+	// world changed (travel) - tick functions were unregistered with old level
+	if (World.Get() != InWorld)
+	{
+		for (TUniquePtr<FBatch>& Batch : Batches)
+		{
+			if (Batch.IsValid() && Batch->TickFunction.IsTickFunctionRegistered())
+			{
+				Batch->TickFunction.UnRegisterTickFunction();
+			}
+		}
+		World = InWorld;
+	}
+
+	if (Batches.Num() <= BatchIndex)
+	{
+		Batches.SetNum(BatchIndex + 1);
+	}
+	TUniquePtr<FBatch>& Batch = Batches[BatchIndex];
+	if (!Batch.IsValid())
+	{
+		Batch = MakeUnique<FBatch>();
+		Batch->TickFunction.Batcher = this;
+		Batch->TickFunction.BatchIndex = BatchIndex;
+		Batch->TickFunction.TickGroup = TG_PrePhysics;
+		Batch->TickFunction.bCanEverTick = true;
+		Batch->TickFunction.bStartWithTickEnabled = false;
+	}
+	if (!Batch->TickFunction.IsTickFunctionRegistered())
+	{
+		Batch->TickFunction.RegisterTickFunction(InWorld->PersistentLevel);
+	}
+	return *Batch;
+}
+
+FUHLEnemyTickBatcher::FBatchedEnemy FUHLEnemyTickBatcher::TakeFromBatch(const FIntPoint& Location)
+{
+	FBatch& Batch = *Batches[Location.X];
+	FBatchedEnemy BatchedEnemy = MoveTemp(Batch.Enemies[Location.Y]);
+
+	Batch.Enemies.RemoveAtSwap(Location.Y, 1, EAllowShrinking::No);
+	if (Batch.Enemies.IsValidIndex(Location.Y))
+	{
+		LocationByEnemy.Add(Batch.Enemies[Location.Y].Key, Location);
+	}
+	if (Batch.Enemies.IsEmpty() && Batch.TickFunction.IsTickFunctionRegistered())
+	{
+		Batch.TickFunction.SetTickFunctionEnable(false);
+	}
+	return BatchedEnemy;
+}
+
+void FUHLEnemyTickBatcher::RestoreNativeTicks(const FBatchedEnemy& BatchedEnemy)
+{
+	// only ticks batch still owns are enabled back, ones disabled before batching or released stay as they are
+	ACharacter* Enemy = BatchedEnemy.Enemy.Get();
+	if (Enemy && BatchedEnemy.bActorTick)
+	{
+		Enemy->SetActorTickEnabled(true);
+	}
+	if (AController* Controller = BatchedEnemy.Controller.Get())
+	{
+		Controller->SetActorTickEnabled(true);
+	}
+	for (const TWeakObjectPtr<UActorComponent>& Component : BatchedEnemy.Components)
+	{
+		// deactivated after last batched tick, keep it disabled
+		if (Component.IsValid() && Component->IsActive())
+		{
+			Component->SetComponentTickEnabled(true);
+		}
+	}
+}
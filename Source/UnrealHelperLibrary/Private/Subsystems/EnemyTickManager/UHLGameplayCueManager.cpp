@@ -0,0 +1,25 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Subsystems/EnemyTickManager/UHLGameplayCueManager.h"
+
+#include "Engine/GameInstance.h"
+#include "GameFramework/Actor.h"
+#include "Subsystems/EnemyTickManager/EnemyTickOptimizerSubsystem.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLGameplayCueManager)
+
+void UUHLGameplayCueManager::HandleGameplayCue(AActor* TargetActor, FGameplayTag GameplayCueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters, EGameplayCueExecutionOptions Options)
+{
+	// HandleGameplayCues also routes every tag through here
+	const UGameInstance* GameInstance = TargetActor ? TargetActor->GetGameInstance() : nullptr;
+	if (const UEnemyTickOptimizerSubsystem* EnemyTickOptimizer = GameInstance ? GameInstance->GetSubsystem<UEnemyTickOptimizerSubsystem>() : nullptr)
+	{
+		if (EnemyTickOptimizer->ShouldSuppressGameplayCue(TargetActor, GameplayCueTag))
+		{
+			return;
+		}
+	}
+
+	Super::HandleGameplayCue(TargetActor, GameplayCueTag, EventType, Parameters, Options);
+}
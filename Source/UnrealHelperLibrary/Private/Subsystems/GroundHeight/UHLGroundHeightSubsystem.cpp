@@ -0,0 +1,248 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Subsystems/GroundHeight/UHLGroundHeightSubsystem.h"
+
+#include "Development/UHLSettings.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLGroundHeightSubsystem)
+
+void UUHLGroundHeightSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Settings = GetDefault<UUHLSettings>()->GroundHeightSubsystemSettings;
+
+	for (const TEnumAsByte<ECollisionChannel>& ObjectType : Settings.GroundObjectTypes)
+	{
+		ObjectQueryParams.AddObjectTypesToQuery(ObjectType);
+	}
+
+	if (Settings.bEnable && Settings.bInvalidateOnActorSpawnAndDestroy)
+	{
+		UWorld* World = GetWorld();
+		ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UUHLGroundHeightSubsystem::OnActorSpawnedOrDestroyed));
+		ActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &UUHLGroundHeightSubsystem::OnActorSpawnedOrDestroyed));
+	}
+}
+
+void UUHLGroundHeightSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+	}
+	Cells.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UUHLGroundHeightSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FUHLGroundSample UUHLGroundHeightSubsystem::GetGround(const FVector& Location, const AActor* IgnoredActor)
+{
+	if (!Settings.bEnable)
+	{
+		return TraceGround(Location, IgnoredActor);
+	}
+
+	const FIntVector CellKey = GetCellKey(Location);
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	if (const FCachedCell* CachedCell = Cells.Find(CellKey))
+	{
+		if (Settings.CellLifetime <= 0.0f || CurrentTime - CachedCell->TimeCached < Settings.CellLifetime)
+		{
+			return IsCachedSampleUsable(*CachedCell, Location, IgnoredActor) ? CachedCell->Sample : TraceGround(Location, IgnoredActor);
+		}
+	}
+
+	// trace from top of Z band at cell center, so every query in this cell gets same answer
+	const FVector TraceStart(
+		(CellKey.X + 0.5) * Settings.CellSize,
+		(CellKey.Y + 0.5) * Settings.CellSize,
+		(CellKey.Z + 1.0) * Settings.HeightBandSize
+	);
+
+	if (Cells.Num() >= Settings.MaxCells)
+	{
+		PruneCells();
+	}
+
+	const AActor* HitActor = nullptr;
+	const FUHLGroundSample Sample = TraceGround(TraceStart, IgnoredActor, &HitActor);
+	// carried props move with their owner, sample would be stale right away
+	if (HitActor && HitActor->GetAttachParentActor())
+	{
+		return TraceGround(Location, IgnoredActor);
+	}
+
+	FCachedCell& CachedCell = Cells.FindOrAdd(CellKey);
+	CachedCell.Sample = Sample;
+	CachedCell.HitActor = HitActor;
+	CachedCell.TimeCached = CurrentTime;
+	return IsCachedSampleUsable(CachedCell, Location, IgnoredActor) ? CachedCell.Sample : TraceGround(Location, IgnoredActor);
+}
+
+bool UUHLGroundHeightSubsystem::IsCachedSampleUsable(const FCachedCell& CachedCell, const FVector& Location, const AActor* IgnoredActor)
+{
+	if (!CachedCell.Sample.bHasGround)
+	{
+		// nothing below top of band - nothing below query point either
+		return true;
+	}
+	// overhang/ceiling between query point and top of band
+	if (CachedCell.Sample.Location.Z > Location.Z)
+	{
+		return false;
+	}
+
+	const AActor* HitActor = CachedCell.HitActor.Get();
+	return !IgnoredActor || !HitActor || (HitActor != IgnoredActor && !HitActor->IsAttachedTo(IgnoredActor));
+}
+
+bool UUHLGroundHeightSubsystem::GetGroundHeight(const FVector& Location, float& OutHeight, FVector* OutNormal, const AActor* IgnoredActor)
+{
+	const FUHLGroundSample Sample = GetGround(Location, IgnoredActor);
+	if (!Sample.bHasGround)
+	{
+		return false;
+	}
+
+	OutHeight = Sample.Location.Z;
+	if (OutNormal)
+	{
+		*OutNormal = Sample.Normal;
+	}
+	return true;
+}
+
+void UUHLGroundHeightSubsystem::InvalidateBox(const FBox& Box)
+{
+	if (Cells.IsEmpty() || !Box.IsValid)
+	{
+		return;
+	}
+
+	const FIntVector MinKey = GetCellKey(Box.Min);
+	// traces start at top of band and go down - cells above box also could hit it
+	const FIntVector MaxKey = GetCellKey(FVector(Box.Max.X, Box.Max.Y, Box.Max.Z + Settings.MaxTraceDistance));
+
+	const int64 NumKeysInBox = int64(MaxKey.X - MinKey.X + 1) * (MaxKey.Y - MinKey.Y + 1) * (MaxKey.Z - MinKey.Z + 1);
+	if (NumKeysInBox > Cells.Num())
+	{
+		for (auto It = Cells.CreateIterator(); It; ++It)
+		{
+			const FIntVector& Key = It.Key();
+			if (Key.X >= MinKey.X && Key.X <= MaxKey.X
+				&& Key.Y >= MinKey.Y && Key.Y <= MaxKey.Y
+				&& Key.Z >= MinKey.Z && Key.Z <= MaxKey.Z)
+			{
+				It.RemoveCurrent();
+			}
+		}
+		return;
+	}
+
+	for (int32 X = MinKey.X; X <= MaxKey.X; X++)
+	{
+		for (int32 Y = MinKey.Y; Y <= MaxKey.Y; Y++)
+		{
+			for (int32 Z = MinKey.Z; Z <= MaxKey.Z; Z++)
+			{
+				Cells.Remove(FIntVector(X, Y, Z));
+			}
+		}
+	}
+}
+
+void UUHLGroundHeightSubsystem::InvalidateActor(const AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	InvalidateBox(Actor->GetComponentsBoundingBox(true));
+}
+
+void UUHLGroundHeightSubsystem::InvalidateAll()
+{
+	Cells.Reset();
+}
+
+FIntVector UUHLGroundHeightSubsystem::GetCellKey(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / Settings.CellSize),
+		FMath::FloorToInt32(Location.Y / Settings.CellSize),
+		FMath::FloorToInt32(Location.Z / Settings.HeightBandSize)
+	);
+}
+
+FUHLGroundSample UUHLGroundHeightSubsystem::TraceGround(const FVector& Start, const AActor* IgnoredActor, const AActor** OutHitActor) const
+{
+	FUHLGroundSample Sample;
+
+	static const FName GroundHeightTraceName = FName("UHLGroundHeight");
+	FCollisionQueryParams QueryParams(GroundHeightTraceName, false, IgnoredActor);
+	if (IgnoredActor)
+	{
+		TArray<AActor*> AttachedActors;
+		IgnoredActor->GetAttachedActors(AttachedActors, true, true);
+		QueryParams.AddIgnoredActors(AttachedActors);
+	}
+
+	FHitResult HitResult;
+	const FVector End = Start - FVector(0, 0, Settings.MaxTraceDistance);
+	if (GetWorld()->LineTraceSingleByObjectType(HitResult, Start, End, ObjectQueryParams, QueryParams)
+		&& HitResult.IsValidBlockingHit())
+	{
+		Sample.bHasGround = true;
+		Sample.Location = HitResult.Location;
+		Sample.Normal = HitResult.ImpactNormal;
+		if (OutHitActor)
+		{
+			*OutHitActor = HitResult.GetActor();
+		}
+	}
+	return Sample;
+}
+
+void UUHLGroundHeightSubsystem::PruneCells()
+{
+	if (Settings.CellLifetime > 0.0f)
+	{
+		const double CurrentTime = GetWorld()->GetTimeSeconds();
+		for (auto It = Cells.CreateIterator(); It; ++It)
+		{
+			if (CurrentTime - It.Value().TimeCached >= Settings.CellLifetime)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	// nothing expired - start over, active areas will be re-cached quickly
+	if (Cells.Num() >= Settings.MaxCells)
+	{
+		Cells.Reset();
+	}
+}
+
+void UUHLGroundHeightSubsystem::OnActorSpawnedOrDestroyed(AActor* Actor)
+{
+	// pawns are not ground, traces with non-pawn channels usually ignore them anyway
+	if (!Actor || Actor->IsA<APawn>() || !Actor->GetActorEnableCollision())
+	{
+		return;
+	}
+
+	InvalidateActor(Actor);
+}
@@ -0,0 +1,262 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Subsystems/LineOfSight/UHLLineOfSightCacheSubsystem.h"
+
+#include "Development/UHLSettings.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Subsystems/DebugGraph/UHLDebugGraphSubsystem.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLLineOfSightCacheSubsystem)
+
+void UUHLLineOfSightCacheSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Settings = GetDefault<UUHLSettings>()->LineOfSightCacheSettings;
+	TraceDelegate.BindUObject(this, &UUHLLineOfSightCacheSubsystem::OnTraceCompleted);
+}
+
+void UUHLLineOfSightCacheSubsystem::Deinitialize()
+{
+	TraceDelegate.Unbind();
+	Pairs.Empty();
+	PendingTraces.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UUHLLineOfSightCacheSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UUHLLineOfSightCacheSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UUHLLineOfSightCacheSubsystem, STATGROUP_Tickables);
+}
+
+bool UUHLLineOfSightCacheSubsystem::GetLineOfSight(AActor* Observer, AActor* Target, bool& bOutHasLineOfSight, float& OutAge, float Priority)
+{
+	bOutHasLineOfSight = false;
+	OutAge = -1.0f;
+
+	if (!IsValid(Observer) || !IsValid(Target))
+	{
+		return false;
+	}
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	FPairState& PairState = FindOrAddPair(Observer, Target);
+	PairState.LastQueryTime = CurrentTime;
+	PairState.Priority = FMath::Max(PairState.Priority, Priority);
+
+	if (!PairState.bHasResult && Settings.bTraceImmediatelyIfUnknown)
+	{
+		TraceImmediately(PairState);
+	}
+
+	if (!PairState.bHasResult)
+	{
+		return false;
+	}
+
+	bOutHasLineOfSight = PairState.bHasLineOfSight;
+	OutAge = CurrentTime - PairState.ResultTime;
+	return true;
+}
+
+void UUHLLineOfSightCacheSubsystem::RequestRefresh(AActor* Observer, AActor* Target)
+{
+	if (!IsValid(Observer) || !IsValid(Target))
+	{
+		return;
+	}
+
+	FPairState& PairState = FindOrAddPair(Observer, Target);
+	PairState.LastQueryTime = GetWorld()->GetTimeSeconds();
+	PairState.bRefreshRequested = true;
+}
+
+void UUHLLineOfSightCacheSubsystem::RemoveActor(AActor* Actor)
+{
+	const TObjectKey<AActor> ActorKey(Actor);
+	for (auto It = Pairs.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Observer == ActorKey || It.Key().Target == ActorKey)
+		{
+			PendingTraces.Remove(It.Value().Id);
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UUHLLineOfSightCacheSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Pairs.IsEmpty())
+	{
+		return;
+	}
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	ScratchCandidates.Reset();
+	for (auto It = Pairs.CreateIterator(); It; ++It)
+	{
+		FPairState& PairState = It.Value();
+		if (CurrentTime - PairState.LastQueryTime > Settings.PairExpireTime
+			|| !PairState.Observer.IsValid() || !PairState.Target.IsValid())
+		{
+			PendingTraces.Remove(PairState.Id);
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (PairState.bTracePending)
+		{
+			continue;
+		}
+
+		const double Age = PairState.bHasResult ? CurrentTime - PairState.ResultTime : UE_DOUBLE_BIG_NUMBER;
+		if (!PairState.bRefreshRequested && Age < Settings.MinRefreshInterval)
+		{
+			continue;
+		}
+
+		const double Score = PairState.bRefreshRequested ? UE_DOUBLE_BIG_NUMBER : Age * PairState.Priority;
+		ScratchCandidates.Emplace(Score, It.Key());
+	}
+
+	const int32 NumTraces = FMath::Min(ScratchCandidates.Num(), Settings.MaxTracesPerFrame);
+	UHL_DEBUG_GRAPH_PUSH(this, TEXT("LineOfSightTraces"), NumTraces);
+	if (NumTraces == 0)
+	{
+		return;
+	}
+
+	// highest score first, full sort not needed when everything fits in budget
+	const auto ByScore = [](const TPair<double, FPairKey>& A, const TPair<double, FPairKey>& B) { return A.Key > B.Key; };
+	if (NumTraces < ScratchCandidates.Num())
+	{
+		ScratchCandidates.Heapify(ByScore);
+	}
+
+	UWorld* World = GetWorld();
+	for (int32 i = 0; i < NumTraces; i++)
+	{
+		TPair<double, FPairKey> Candidate;
+		if (NumTraces < ScratchCandidates.Num())
+		{
+			ScratchCandidates.HeapPop(Candidate, ByScore, EAllowShrinking::No);
+		}
+		else
+		{
+			Candidate = ScratchCandidates[i];
+		}
+
+		FPairState& PairState = Pairs.FindChecked(Candidate.Value);
+
+		FVector Start, End;
+		FCollisionQueryParams QueryParams;
+		if (!GetTracePoints(PairState, Start, End, QueryParams))
+		{
+			continue;
+		}
+
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, Settings.TraceChannel, QueryParams,
+			FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, PairState.Id);
+
+		PairState.bTracePending = true;
+		PairState.bRefreshRequested = false;
+		// priority is accumulated between refreshes
+		PairState.Priority = 0.0f;
+		PendingTraces.Add(PairState.Id, Candidate.Value);
+	}
+}
+
+UUHLLineOfSightCacheSubsystem::FPairState& UUHLLineOfSightCacheSubsystem::FindOrAddPair(AActor* Observer, AActor* Target)
+{
+	const FPairKey PairKey{ Observer, Target };
+	FPairState* PairState = Pairs.Find(PairKey);
+	if (!PairState)
+	{
+		PairState = &Pairs.Add(PairKey);
+		PairState->Observer = Observer;
+		PairState->Target = Target;
+		PairState->Id = NextPairId++;
+		PairState->Priority = 0.0f;
+	}
+	return *PairState;
+}
+
+bool UUHLLineOfSightCacheSubsystem::GetTracePoints(const FPairState& PairState, FVector& OutStart, FVector& OutEnd, FCollisionQueryParams& OutQueryParams) const
+{
+	const AActor* Observer = PairState.Observer.Get();
+	const AActor* Target = PairState.Target.Get();
+	if (!Observer || !Target)
+	{
+		return false;
+	}
+
+	FRotator EyesRotation;
+	Observer->GetActorEyesViewPoint(OutStart, EyesRotation);
+	OutEnd = Target->GetActorLocation();
+
+	static const FName LineOfSightTraceName = FName("UHLLineOfSightCache");
+	OutQueryParams = FCollisionQueryParams(LineOfSightTraceName, false, Observer);
+	return true;
+}
+
+bool UUHLLineOfSightCacheSubsystem::IsLineOfSightHit(const FPairState& PairState, const TArray<FHitResult>& Hits) const
+{
+	for (const FHitResult& Hit : Hits)
+	{
+		if (Hit.bBlockingHit)
+		{
+			return Hit.GetActor() == PairState.Target.Get();
+		}
+	}
+	return true;
+}
+
+void UUHLLineOfSightCacheSubsystem::TraceImmediately(FPairState& PairState)
+{
+	FVector Start, End;
+	FCollisionQueryParams QueryParams;
+	if (!GetTracePoints(PairState, Start, End, QueryParams))
+	{
+		return;
+	}
+
+	FHitResult HitResult;
+	GetWorld()->LineTraceSingleByChannel(HitResult, Start, End, Settings.TraceChannel, QueryParams);
+
+	PairState.bHasResult = true;
+	PairState.bHasLineOfSight = !HitResult.bBlockingHit || HitResult.GetActor() == PairState.Target.Get();
+	PairState.ResultTime = GetWorld()->GetTimeSeconds();
+}
+
+void UUHLLineOfSightCacheSubsystem::OnTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	FPairKey PairKey;
+	if (!PendingTraces.RemoveAndCopyValue(TraceDatum.UserData, PairKey))
+	{
+		// pair removed while trace was in flight
+		return;
+	}
+
+	FPairState* PairState = Pairs.Find(PairKey);
+	if (!PairState)
+	{
+		return;
+	}
+
+	PairState->bTracePending = false;
+	PairState->bHasResult = true;
+	PairState->bHasLineOfSight = IsLineOfSightHit(*PairState, TraceDatum.OutHits);
+	PairState->ResultTime = GetWorld()->GetTimeSeconds();
+}
@@ -0,0 +1,286 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Subsystems/NavDistanceField/UHLNavDistanceFieldSubsystem.h"
+
+#include "Development/UHLSettings.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "NavigationSystem.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "Subsystems/DebugGraph/UHLDebugGraphSubsystem.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLNavDistanceFieldSubsystem)
+
+void UUHLNavDistanceFieldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Settings = GetDefault<UUHLSettings>()->NavDistanceFieldSettings;
+
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &UUHLNavDistanceFieldSubsystem::OnNavigationGenerationFinished);
+	}
+}
+
+void UUHLNavDistanceFieldSubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &UUHLNavDistanceFieldSubsystem::OnNavigationGenerationFinished);
+	}
+	Fields.Empty();
+	PolyCenters.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UUHLNavDistanceFieldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UUHLNavDistanceFieldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UUHLNavDistanceFieldSubsystem, STATGROUP_Tickables);
+}
+
+void UUHLNavDistanceFieldSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!Settings.bEnable)
+	{
+		return;
+	}
+
+	const ARecastNavMesh* NavMesh = GetNavMesh();
+	if (!NavMesh)
+	{
+		return;
+	}
+
+	UpdatePlayers();
+
+	int32 Budget = Settings.MaxPolysPerFrame;
+	for (FField& Field : Fields)
+	{
+		const APawn* Player = Field.Player.Get();
+		if (!Player)
+		{
+			continue;
+		}
+
+		const FVector PlayerLocation = Player->GetNavAgentLocation();
+		if (!Field.bBuilding
+			&& (!Field.bHasReady || FVector::DistSquared(PlayerLocation, Field.Ready.Origin) > FMath::Square(Settings.RebuildDistance)))
+		{
+			StartBuild(Field, PlayerLocation, NavMesh);
+		}
+
+		if (Field.bBuilding && Budget > 0)
+		{
+			Budget -= ContinueBuild(Field, NavMesh, Budget);
+		}
+	}
+
+	UHL_DEBUG_GRAPH_PUSH(this, TEXT("NavDistanceFieldPolys"), Settings.MaxPolysPerFrame - Budget);
+}
+
+bool UUHLNavDistanceFieldSubsystem::GetPathDistanceToPlayer(const APawn* Player, FVector Location, float& OutDistance) const
+{
+	const FField* Field = FindField(Player);
+	return Field && GetFieldDistance(*Field, Location, OutDistance);
+}
+
+bool UUHLNavDistanceFieldSubsystem::GetDirectionToPlayer(const APawn* Player, FVector Location, FVector& OutDirection) const
+{
+	OutDirection = FVector::ZeroVector;
+
+	const FField* Field = FindField(Player);
+	const ARecastNavMesh* NavMesh = GetNavMesh();
+	if (!Field || !Field->bHasReady || !NavMesh)
+	{
+		return false;
+	}
+
+	const NavNodeRef Poly = NavMesh->FindNearestPoly(Location, NavMesh->GetDefaultQueryExtent(), NavMesh->GetDefaultQueryFilter());
+	const FNode* Node = Field->Ready.Nodes.Find(Poly);
+	if (!Node)
+	{
+		return false;
+	}
+
+	const bool bOriginNext = Poly == Field->Ready.OriginPoly || Node->Parent == Field->Ready.OriginPoly;
+	const FVector Target = bOriginNext ? Field->Ready.Origin : GetPolyCenter(NavMesh, Node->Parent);
+	OutDirection = (Target - Location).GetSafeNormal();
+	return true;
+}
+
+bool UUHLNavDistanceFieldSubsystem::GetPathDistanceFromOrigin(FVector Origin, FVector Location, float& OutDistance) const
+{
+	const float ToleranceSquared = FMath::Square(Settings.OriginMatchTolerance);
+	for (const FField& Field : Fields)
+	{
+		if (Field.bHasReady && FVector::DistSquared(Field.Ready.Origin, Origin) <= ToleranceSquared)
+		{
+			return GetFieldDistance(Field, Location, OutDistance);
+		}
+	}
+	return false;
+}
+
+bool UUHLNavDistanceFieldSubsystem::IsFieldReady(const APawn* Player) const
+{
+	const FField* Field = FindField(Player);
+	return Field && Field->bHasReady;
+}
+
+ARecastNavMesh* UUHLNavDistanceFieldSubsystem::GetNavMesh() const
+{
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	return NavSys ? Cast<ARecastNavMesh>(NavSys->GetDefaultNavDataInstance()) : nullptr;
+}
+
+FVector UUHLNavDistanceFieldSubsystem::GetPolyCenter(const ARecastNavMesh* NavMesh, NavNodeRef Poly) const
+{
+	if (const FVector* Center = PolyCenters.Find(Poly))
+	{
+		return *Center;
+	}
+
+	FVector Center = FVector::ZeroVector;
+	NavMesh->GetPolyCenter(Poly, Center);
+	return PolyCenters.Add(Poly, Center);
+}
+
+const UUHLNavDistanceFieldSubsystem::FField* UUHLNavDistanceFieldSubsystem::FindField(const APawn* Player) const
+{
+	return Player ? Fields.FindByPredicate([Player](const FField& Field) { return Field.Player.Get() == Player; }) : nullptr;
+}
+
+void UUHLNavDistanceFieldSubsystem::UpdatePlayers()
+{
+	Fields.RemoveAllSwap([](const FField& Field) { return !Field.Player.IsValid(); }, EAllowShrinking::No);
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		APawn* Player = PlayerController ? PlayerController->GetPawn() : nullptr;
+		if (Player && !FindField(Player))
+		{
+			Fields.AddDefaulted_GetRef().Player = Player;
+		}
+	}
+}
+
+void UUHLNavDistanceFieldSubsystem::StartBuild(FField& Field, const FVector& Origin, const ARecastNavMesh* NavMesh)
+{
+	const NavNodeRef OriginPoly = NavMesh->FindNearestPoly(Origin, NavMesh->GetDefaultQueryExtent(), NavMesh->GetDefaultQueryFilter());
+	if (OriginPoly == INVALID_NAVNODEREF)
+	{
+		// player off navmesh (jumping, falling), keep previous field
+		return;
+	}
+
+	Field.Building.Origin = Origin;
+	Field.Building.OriginPoly = OriginPoly;
+	Field.Building.Nodes.Reset();
+	Field.Building.Nodes.Add(OriginPoly, FNode{ 0.0f, INVALID_NAVNODEREF });
+	Field.OpenHeap.Reset();
+	Field.OpenHeap.HeapPush(FOpenNode{ 0.0f, OriginPoly });
+	Field.bBuilding = true;
+}
+
+int32 UUHLNavDistanceFieldSubsystem::ContinueBuild(FField& Field, const ARecastNavMesh* NavMesh, int32 Budget)
+{
+	int32 Expanded = 0;
+	while (Expanded < Budget && !Field.OpenHeap.IsEmpty())
+	{
+		FOpenNode OpenNode;
+		Field.OpenHeap.HeapPop(OpenNode, EAllowShrinking::No);
+
+		// heap keeps outdated entries instead of decrease-key
+		const FNode* Node = Field.Building.Nodes.Find(OpenNode.Poly);
+		if (!Node || OpenNode.Distance > Node->Distance)
+		{
+			continue;
+		}
+		Expanded++;
+
+		const FVector Center = GetPolyCenter(NavMesh, OpenNode.Poly);
+		ScratchNeighbors.Reset();
+		NavMesh->GetPolyNeighbors(OpenNode.Poly, ScratchNeighbors);
+		for (const NavNodeRef Neighbor : ScratchNeighbors)
+		{
+			const float Distance = OpenNode.Distance + FVector::Dist(Center, GetPolyCenter(NavMesh, Neighbor));
+			if (Distance > Settings.MaxPathDistance)
+			{
+				continue;
+			}
+
+			FNode& NeighborNode = Field.Building.Nodes.FindOrAdd(Neighbor);
+			if (Distance < NeighborNode.Distance)
+			{
+				NeighborNode.Distance = Distance;
+				NeighborNode.Parent = OpenNode.Poly;
+				Field.OpenHeap.HeapPush(FOpenNode{ Distance, Neighbor });
+			}
+		}
+	}
+
+	if (Field.OpenHeap.IsEmpty())
+	{
+		Swap(Field.Ready, Field.Building);
+		Field.Building.Nodes.Reset();
+		Field.bHasReady = true;
+		Field.bBuilding = false;
+	}
+	return Expanded;
+}
+
+bool UUHLNavDistanceFieldSubsystem::GetFieldDistance(const FField& Field, const FVector& Location, float& OutDistance) const
+{
+	OutDistance = FLT_MAX;
+
+	const ARecastNavMesh* NavMesh = GetNavMesh();
+	if (!Field.bHasReady || !NavMesh)
+	{
+		return false;
+	}
+
+	const NavNodeRef Poly = NavMesh->FindNearestPoly(Location, NavMesh->GetDefaultQueryExtent(), NavMesh->GetDefaultQueryFilter());
+	const FNode* Node = Field.Ready.Nodes.Find(Poly);
+	if (!Node)
+	{
+		return false;
+	}
+
+	if (Poly == Field.Ready.OriginPoly)
+	{
+		OutDistance = FVector::Dist(Location, Field.Ready.Origin);
+		return true;
+	}
+
+	// field distance is between polygon centers, add ends of path
+	OutDistance = Node->Distance
+		+ FVector::Dist(Location, GetPolyCenter(NavMesh, Poly))
+		+ FVector::Dist(Field.Ready.Origin, GetPolyCenter(NavMesh, Field.Ready.OriginPoly));
+	return true;
+}
+
+void UUHLNavDistanceFieldSubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	// polygon refs may point to other polygons now
+	PolyCenters.Reset();
+	for (FField& Field : Fields)
+	{
+		Field.Ready.Nodes.Reset();
+		Field.Building.Nodes.Reset();
+		Field.OpenHeap.Reset();
+		Field.bHasReady = false;
+		Field.bBuilding = false;
+	}
+}
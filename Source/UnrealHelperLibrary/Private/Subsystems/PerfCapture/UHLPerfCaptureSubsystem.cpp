@@ -0,0 +1,226 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Subsystems/PerfCapture/UHLPerfCaptureSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Subsystems/DebugGraph/UHLDebugGraphSubsystem.h"
+#include "UnrealHelperLibrary.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UHLPerfCaptureSubsystem)
+
+CSV_DEFINE_CATEGORY(UHL, true);
+
+namespace UHLPerfCapture
+{
+	const FName FrameTimeMetricName = TEXT("FrameTimeMs");
+	const FName GameThreadMetricName = TEXT("GameThreadMs");
+	const FName UsedMemoryMetricName = TEXT("UsedPhysicalMB");
+
+	float GetPercentile(const TArray<float>& SortedValues, float Percentile)
+	{
+		const int32 Index = FMath::Clamp(FMath::CeilToInt32(Percentile * SortedValues.Num()) - 1, 0, SortedValues.Num() - 1);
+		return SortedValues[Index];
+	}
+}
+
+bool UUHLPerfCaptureSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && FCString::Strifind(FCommandLine::Get(), TEXT("-UHLPerfCapture")) != nullptr;
+}
+
+void UUHLPerfCaptureSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	if (!FParse::Value(CommandLine, TEXT("UHLPerfCapture="), CaptureName) || CaptureName.IsEmpty())
+	{
+		CaptureName = FPaths::GetBaseFilename(GetWorld()->GetMapName());
+	}
+	FParse::Value(CommandLine, TEXT("UHLPerfCaptureDuration="), Duration);
+	FParse::Value(CommandLine, TEXT("UHLPerfCaptureWarmup="), WarmupTime);
+	if (!FParse::Value(CommandLine, TEXT("UHLPerfCaptureOutput="), OutputDir))
+	{
+		OutputDir = FPaths::ProfilingDir() / TEXT("UHLPerfCapture");
+	}
+
+	FString Exec;
+	if (FParse::Value(CommandLine, TEXT("UHLPerfCaptureExec="), Exec, false))
+	{
+		Exec.TrimQuotesInline();
+		Exec.ParseIntoArray(ScenarioCommands, TEXT(";"));
+	}
+
+	StateStartTime = FPlatformTime::Seconds();
+	LastFrameTime = StateStartTime;
+	UE_LOG(LogUnrealHelperLibrary, Display, TEXT("PerfCapture: \"%s\" warmup %.1fs, capture %.1fs"), *CaptureName, WarmupTime, Duration);
+}
+
+void UUHLPerfCaptureSubsystem::Deinitialize()
+{
+	// map changed or game closed before capture finished - still keep what was recorded
+	if (State == EState::Capturing)
+	{
+		FinishCapture();
+	}
+
+	Super::Deinitialize();
+}
+
+bool UUHLPerfCaptureSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UUHLPerfCaptureSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UUHLPerfCaptureSubsystem, STATGROUP_Tickables);
+}
+
+void UUHLPerfCaptureSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	const double FrameSeconds = CurrentTime - LastFrameTime;
+	LastFrameTime = CurrentTime;
+
+	switch (State)
+	{
+		case EState::Warmup:
+			if (CurrentTime - StateStartTime >= WarmupTime)
+			{
+				StartCapture();
+			}
+			break;
+
+		case EState::Capturing:
+		{
+			// idle time is frame rate limiter wait, rest is game thread work
+			RecordSample(UHLPerfCapture::FrameTimeMetricName, FrameSeconds * 1000.0);
+			RecordSample(UHLPerfCapture::GameThreadMetricName, FMath::Max(FrameSeconds - FApp::GetIdleTime(), 0.0) * 1000.0);
+			RecordSample(UHLPerfCapture::UsedMemoryMetricName, FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0));
+
+			if (CurrentTime - StateStartTime >= Duration)
+			{
+				FinishCapture();
+				FPlatformMisc::RequestExit(false);
+			}
+			break;
+		}
+
+		default:
+			break;
+	}
+}
+
+void UUHLPerfCaptureSubsystem::StartCapture()
+{
+	State = EState::Capturing;
+	StateStartTime = FPlatformTime::Seconds();
+
+	if (UUHLDebugGraphSubsystem* DebugGraph = GetWorld()->GetSubsystem<UUHLDebugGraphSubsystem>())
+	{
+		DebugGraphHandle = DebugGraph->OnValuePushed.AddUObject(this, &UUHLPerfCaptureSubsystem::RecordSample);
+	}
+
+	for (const FString& Command : ScenarioCommands)
+	{
+		GEngine->Exec(GetWorld(), *Command.TrimStartAndEnd());
+	}
+
+#if CSV_PROFILER
+	if (FCsvProfiler* CsvProfiler = FCsvProfiler::Get())
+	{
+		CsvProfiler->BeginCapture(-1, OutputDir, CaptureName + TEXT(".csv"));
+	}
+#endif
+
+	UE_LOG(LogUnrealHelperLibrary, Display, TEXT("PerfCapture: \"%s\" started"), *CaptureName);
+}
+
+void UUHLPerfCaptureSubsystem::FinishCapture()
+{
+	State = EState::Done;
+
+	if (UUHLDebugGraphSubsystem* DebugGraph = GetWorld()->GetSubsystem<UUHLDebugGraphSubsystem>())
+	{
+		DebugGraph->OnValuePushed.Remove(DebugGraphHandle);
+	}
+
+#if CSV_PROFILER
+	if (FCsvProfiler* CsvProfiler = FCsvProfiler::Get(); CsvProfiler && CsvProfiler->IsCapturing())
+	{
+		CsvProfiler->EndCapture();
+	}
+#endif
+
+	WriteSummary();
+}
+
+void UUHLPerfCaptureSubsystem::RecordSample(FName MetricName, float Value)
+{
+	if (State != EState::Capturing)
+	{
+		return;
+	}
+
+	Samples.FindOrAdd(MetricName).Add(Value);
+
+#if CSV_PROFILER
+	FCsvProfiler::RecordCustomStat(MetricName, CSV_CATEGORY_INDEX(UHL), Value, ECsvCustomStatOp::Set);
+#endif
+}
+
+void UUHLPerfCaptureSubsystem::WriteSummary() const
+{
+	FString Summary = FString::Printf(TEXT("# Capture,%s\n# Map,%s\n# Build,%s\n# Duration,%.1f\n"),
+		*CaptureName, *GetWorld()->GetMapName(), LexToString(FApp::GetBuildConfiguration()), Duration);
+	Summary += TEXT("Metric,Samples,Min,Avg,Median,P95,Max\n");
+
+	// sorted by name, so summaries of different runs can be diffed
+	TArray<FName> MetricNames;
+	Samples.GetKeys(MetricNames);
+	MetricNames.Sort(FNameLexicalLess());
+
+	TArray<float> SortedValues;
+	for (const FName& MetricName : MetricNames)
+	{
+		SortedValues = Samples.FindChecked(MetricName);
+		if (SortedValues.IsEmpty())
+		{
+			continue;
+		}
+		SortedValues.Sort();
+
+		double Sum = 0.0;
+		for (const float Value : SortedValues)
+		{
+			Sum += Value;
+		}
+
+		Summary += FString::Printf(TEXT("%s,%d,%.3f,%.3f,%.3f,%.3f,%.3f\n"),
+			*MetricName.ToString(), SortedValues.Num(),
+			SortedValues[0], Sum / SortedValues.Num(),
+			UHLPerfCapture::GetPercentile(SortedValues, 0.5f), UHLPerfCapture::GetPercentile(SortedValues, 0.95f),
+			SortedValues.Last());
+	}
+
+	const FString SummaryPath = OutputDir / (CaptureName + TEXT("_Summary.csv"));
+	if (FFileHelper::SaveStringToFile(Summary, *SummaryPath))
+	{
+		UE_LOG(LogUnrealHelperLibrary, Display, TEXT("PerfCapture: summary written to %s"), *SummaryPath);
+	}
+	else
+	{
+		UE_LOG(LogUnrealHelperLibrary, Error, TEXT("PerfCapture: failed to write summary to %s"), *SummaryPath);
+	}
+}
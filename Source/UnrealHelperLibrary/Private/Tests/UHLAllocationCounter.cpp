@@ -0,0 +1,127 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Tests/UHLAllocationCounter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include <atomic>
+
+namespace UHLAllocationCounter
+{
+	class FCountingMalloc : public FMalloc
+	{
+	public:
+		void Install()
+		{
+			check(GMalloc != this);
+			InnerMalloc = GMalloc;
+			GMalloc = this;
+		}
+		void Uninstall()
+		{
+			// something wrapped GMalloc while counting, leave chain intact
+			if (ensure(GMalloc == this))
+			{
+				GMalloc = InnerMalloc;
+			}
+		}
+
+		void StartCounting()
+		{
+			check(CountingThreadId.load() == 0);
+			NumAllocations = 0;
+			CountingThreadId = FPlatformTLS::GetCurrentThreadId();
+		}
+		void StopCounting() { CountingThreadId = 0; }
+		int32 GetNumAllocations() const { return NumAllocations; }
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->Malloc(Count, Alignment);
+		}
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->TryMalloc(Count, Alignment);
+		}
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			// realloc to zero is free
+			if (Count > 0)
+			{
+				CountAllocation();
+			}
+			return InnerMalloc->Realloc(Original, Count, Alignment);
+		}
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0)
+			{
+				CountAllocation();
+			}
+			return InnerMalloc->TryRealloc(Original, Count, Alignment);
+		}
+		virtual void Free(void* Original) override { InnerMalloc->Free(Original); }
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return InnerMalloc->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return InnerMalloc->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { InnerMalloc->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { InnerMalloc->SetupTLSCachesOnCurrentThread(); }
+		virtual void MarkTLSCachesAsUsedOnCurrentThread() override { InnerMalloc->MarkTLSCachesAsUsedOnCurrentThread(); }
+		virtual void MarkTLSCachesAsUnusedOnCurrentThread() override { InnerMalloc->MarkTLSCachesAsUnusedOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void UpdateStats() override { InnerMalloc->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { InnerMalloc->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { InnerMalloc->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return InnerMalloc->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return InnerMalloc->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return InnerMalloc->GetDescriptiveName(); }
+
+	private:
+		FMalloc* InnerMalloc = nullptr;
+		std::atomic<uint32> CountingThreadId = 0;
+		// written only by counting thread
+		int32 NumAllocations = 0;
+
+		void CountAllocation()
+		{
+			if (CountingThreadId.load(std::memory_order_relaxed) == FPlatformTLS::GetCurrentThreadId())
+			{
+				NumAllocations++;
+			}
+		}
+	};
+
+	FCountingMalloc& Get()
+	{
+		// never destroyed, other threads may still be inside wrapper after it's uninstalled,
+		// memory allocated through it is freed by inner allocator anyway
+		static FCountingMalloc* CountingMalloc = new FCountingMalloc();
+		return *CountingMalloc;
+	}
+}
+
+FUHLScopedAllocationCounter::FUHLScopedAllocationCounter()
+{
+	UHLAllocationCounter::FCountingMalloc& CountingMalloc = UHLAllocationCounter::Get();
+	CountingMalloc.Install();
+	CountingMalloc.StartCounting();
+}
+
+FUHLScopedAllocationCounter::~FUHLScopedAllocationCounter()
+{
+	UHLAllocationCounter::FCountingMalloc& CountingMalloc = UHLAllocationCounter::Get();
+	CountingMalloc.StopCounting();
+	CountingMalloc.Uninstall();
+}
+
+int32 FUHLScopedAllocationCounter::GetNumAllocations() const
+{
+	return UHLAllocationCounter::Get().GetNumAllocations();
+}
+
+#endif
@@ -0,0 +1,24 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Counts heap allocations (Malloc/Realloc) made by current thread while in scope.
+ * GMalloc is wrapped by forwarding allocator only while counter is alive and restored on destruction,
+ * allocations of other threads (task workers, render thread) aren't counted, so counts are deterministic.
+ * Only one counter can be active at a time.
+ */
+class FUHLScopedAllocationCounter
+{
+public:
+	FUHLScopedAllocationCounter();
+	~FUHLScopedAllocationCounter();
+
+	int32 GetNumAllocations() const;
+};
+
+#endif
@@ -0,0 +1,323 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/UHLAllocationCounter.h"
+#include "Animation/AnimNotifyQueue.h"
+#include "Animation/Notifies/ANS_UHL_DisableWalkOffLedges.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Subsystems/ActorTagIndex/UHLActorTagIndexSubsystem.h"
+#include "Subsystems/EnemyTickManager/EnemyTickOptimizerSubsystem.h"
+#include "Utils/UHLTraceUtilsBPL.h"
+#include "Utils/UnrealHelperLibraryBPL.h"
+
+namespace UHLAllocationTests
+{
+	// Steady state calls counted after one warm-up call, so lazy one-time allocations (first FName, caches) aren't counted
+	constexpr int32 NumIterations = 100;
+
+	/** Allocation budgets per steady state call **/
+	constexpr int32 FindAttachedActorByTagBudget = 0;
+	constexpr int32 GetMostDistantActorComponentBudget = 0;
+	constexpr int32 IsOtherActorInAngleBudget = 0;
+	constexpr int32 DisabledDebugPrintStringsBudget = 0;
+	constexpr int32 UpdateTickIntervalsBudget = 0;
+	constexpr int32 NotifyBeginEndBudget = 0;
+	// ParallelFor task launch and scene query scratch per chunk, per-candidate allocations would blow it
+	constexpr int32 OverlapBlockingTestBatchPerChunkBudget = 8;
+	/** ~Allocation budgets per steady state call **/
+
+	// Standalone game world (no editor/PIE needed), destroyed when out of scope
+	struct FTestWorld
+	{
+		UGameInstance* GameInstance = nullptr;
+		UWorld* World = nullptr;
+
+		FTestWorld()
+		{
+			GameInstance = NewObject<UGameInstance>(GEngine);
+			GameInstance->AddToRoot();
+			GameInstance->InitializeStandalone();
+			World = GameInstance->GetWorld();
+		}
+
+		~FTestWorld()
+		{
+			GameInstance->Shutdown();
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+			GameInstance->RemoveFromRoot();
+		}
+
+		template <typename ActorType>
+		ActorType* Spawn(const FVector& Location = FVector::ZeroVector, const FRotator& Rotation = FRotator::ZeroRotator) const
+		{
+			FActorSpawnParameters SpawnParameters;
+			SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			return World->SpawnActor<ActorType>(Location, Rotation, SpawnParameters);
+		}
+	};
+
+	template <typename FunctionType>
+	int32 CountSteadyStateAllocations(FunctionType&& Function)
+	{
+		Function();
+
+		FUHLScopedAllocationCounter AllocationCounter;
+		for (int32 i = 0; i < NumIterations; i++)
+		{
+			Function();
+		}
+		return AllocationCounter.GetNumAllocations();
+	}
+
+	bool TestAllocationBudget(FAutomationTestBase& Test, const TCHAR* What, int32 NumAllocations, int32 BudgetPerCall)
+	{
+		return Test.TestTrue(
+			FString::Printf(TEXT("%s allocations per call %.2f, budget %d"), What, static_cast<float>(NumAllocations) / NumIterations, BudgetPerCall),
+			NumAllocations <= BudgetPerCall * NumIterations);
+	}
+}
+
+/** BPL queries **/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUHLFindAttachedActorByTagAllocationTest, "UnrealHelperLibrary.Allocations.BPL.FindAttachedActorByTag",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FUHLFindAttachedActorByTagAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace UHLAllocationTests;
+
+	const FTestWorld TestWorld;
+	ACharacter* Parent = TestWorld.Spawn<ACharacter>();
+	ACharacter* Child = TestWorld.Spawn<ACharacter>();
+	ACharacter* GrandChild = TestWorld.Spawn<ACharacter>();
+	Child->AttachToActor(Parent, FAttachmentTransformRules::KeepRelativeTransform);
+	GrandChild->AttachToActor(Child, FAttachmentTransformRules::KeepRelativeTransform);
+
+	const FName IndexedTag = TEXT("UHL.Test.Indexed");
+	const FName NotIndexedTag = TEXT("UHL.Test.NotIndexed");
+	const FName MissingTag = TEXT("UHL.Test.Missing");
+	if (UUHLActorTagIndexSubsystem* TagIndexSubsystem = UWorld::GetSubsystem<UUHLActorTagIndexSubsystem>(TestWorld.World))
+	{
+		TagIndexSubsystem->AddActorTag(GrandChild, IndexedTag);
+	}
+	else
+	{
+		GrandChild->Tags.Add(IndexedTag);
+	}
+	// added after spawn without subsystem - found by attachments walk
+	GrandChild->Tags.Add(NotIndexedTag);
+
+	TestTrue(TEXT("Indexed tag found"), UUnrealHelperLibraryBPL::FindAttachedActorByTag(Parent, IndexedTag) == GrandChild);
+	TestTrue(TEXT("Not indexed tag found"), UUnrealHelperLibraryBPL::FindAttachedActorByTag(Parent, NotIndexedTag) == GrandChild);
+
+	const int32 NumAllocations = CountSteadyStateAllocations([&]()
+	{
+		UUnrealHelperLibraryBPL::FindAttachedActorByTag(Parent, IndexedTag);
+		UUnrealHelperLibraryBPL::FindAttachedActorByTag(Parent, NotIndexedTag);
+		UUnrealHelperLibraryBPL::FindAttachedActorByTag(Parent, MissingTag);
+	});
+	TestAllocationBudget(*this, TEXT("FindAttachedActorByTag"), NumAllocations, FindAttachedActorByTagBudget * 3);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUHLGetMostDistantActorComponentAllocationTest, "UnrealHelperLibrary.Allocations.BPL.GetMostDistantActorComponent",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FUHLGetMostDistantActorComponentAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace UHLAllocationTests;
+
+	const FTestWorld TestWorld;
+	TArray<USceneComponent*> SceneComponents;
+	for (int32 i = 0; i < 16; i++)
+	{
+		SceneComponents.Add(TestWorld.Spawn<ACharacter>(FVector(i * 100.0f, 0.0f, 0.0f))->GetRootComponent());
+	}
+
+	float MaxDistance = 0.0f;
+	int32 Index = INDEX_NONE;
+	UUnrealHelperLibraryBPL::GetMostDistantActorComponent(TestWorld.World, SceneComponents, FVector::ZeroVector, MaxDistance, Index);
+	TestEqual(TEXT("Most distant component index"), Index, SceneComponents.Num() - 1);
+
+	const int32 NumAllocations = CountSteadyStateAllocations([&]()
+	{
+		UUnrealHelperLibraryBPL::GetMostDistantActorComponent(TestWorld.World, SceneComponents, FVector::ZeroVector, MaxDistance, Index);
+	});
+	TestAllocationBudget(*this, TEXT("GetMostDistantActorComponent"), NumAllocations, GetMostDistantActorComponentBudget);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUHLIsOtherActorInAngleAllocationTest, "UnrealHelperLibrary.Allocations.BPL.IsOtherActorInAngle",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FUHLIsOtherActorInAngleAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace UHLAllocationTests;
+
+	const FTestWorld TestWorld;
+	ACharacter* Actor = TestWorld.Spawn<ACharacter>();
+	ACharacter* OtherActor = TestWorld.Spawn<ACharacter>(FVector(500.0f, 100.0f, 0.0f));
+	const TArray<FFloatRange> Ranges = {
+		FFloatRange(-180.0f, -90.0f),
+		FFloatRange(-45.0f, 45.0f),
+		FFloatRange(90.0f, 180.0f),
+	};
+
+	const int32 NumAllocations = CountSteadyStateAllocations([&]()
+	{
+		UUnrealHelperLibraryBPL::IsOtherActorInAngle(Actor, OtherActor, Ranges);
+	});
+	TestAllocationBudget(*this, TEXT("IsOtherActorInAngle"), NumAllocations, IsOtherActorInAngleBudget);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUHLDisabledDebugPrintStringsAllocationTest, "UnrealHelperLibrary.Allocations.BPL.DisabledDebugPrintStrings",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FUHLDisabledDebugPrintStringsAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace UHLAllocationTests;
+
+	const FString A = TEXT("Health: ");
+	const FString B = TEXT("100");
+	const FString C = TEXT(", Stamina: ");
+	const FString D = TEXT("50");
+
+	const int32 NumAllocations = CountSteadyStateAllocations([&]()
+	{
+		UUnrealHelperLibraryBPL::DebugPrintStrings(A, B, C, D, FString(), FString(), FString(), FString(), FString(), FString(), 2.0f, NAME_None, false);
+	});
+	TestAllocationBudget(*this, TEXT("Disabled DebugPrintStrings"), NumAllocations, DisabledDebugPrintStringsBudget);
+	return true;
+}
+/** ~BPL queries **/
+
+/** Tick optimizer **/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUHLEnemyTickOptimizerAllocationTest, "UnrealHelperLibrary.Allocations.EnemyTickOptimizer.UpdateTickIntervals",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FUHLEnemyTickOptimizerAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace UHLAllocationTests;
+
+	const FTestWorld TestWorld;
+	UEnemyTickOptimizerSubsystem* TickOptimizer = TestWorld.GameInstance->GetSubsystem<UEnemyTickOptimizerSubsystem>();
+	if (!TestNotNull(TEXT("EnemyTickOptimizerSubsystem"), TickOptimizer))
+	{
+		return false;
+	}
+
+	APlayerController* PlayerController = TestWorld.Spawn<APlayerController>();
+	ACharacter* PlayerCharacter = TestWorld.Spawn<ACharacter>();
+	PlayerController->Possess(PlayerCharacter);
+
+	// enemies spread over all tiers
+	TArray<ACharacter*> Enemies;
+	for (int32 i = 0; i < 32; i++)
+	{
+		ACharacter* Enemy = TestWorld.Spawn<ACharacter>(FVector(500.0f + i * 250.0f, i * 100.0f, 0.0f));
+		TickOptimizer->RegisterEnemy(Enemy);
+		Enemies.Add(Enemy);
+	}
+
+	// batching takes enemies out of native tick, measure both paths
+	for (const bool bBatchTicks : { false, true })
+	{
+		FEnemyTickOptimizerSubsystemSettings Settings = TickOptimizer->Settings;
+		Settings.bBatchTicks = bBatchTicks;
+		TickOptimizer->ApplySettings(Settings);
+
+		const int32 NumAllocations = CountSteadyStateAllocations([&]()
+		{
+			TickOptimizer->UpdateTickIntervals();
+		});
+		TestAllocationBudget(*this, bBatchTicks ? TEXT("UpdateTickIntervals (batched)") : TEXT("UpdateTickIntervals"), NumAllocations, UpdateTickIntervalsBudget);
+	}
+
+	for (ACharacter* Enemy : Enemies)
+	{
+		TickOptimizer->UnregisterEnemy(Enemy);
+	}
+	return true;
+}
+/** ~Tick optimizer **/
+
+/** Notifies **/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUHLNotifyAllocationTest, "UnrealHelperLibrary.Allocations.Notifies.DisableWalkOffLedges",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FUHLNotifyAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace UHLAllocationTests;
+
+	const FTestWorld TestWorld;
+	ACharacter* Character = TestWorld.Spawn<ACharacter>();
+	USkeletalMeshComponent* MeshComp = Character->GetMesh();
+	UANS_UHL_DisableWalkOffLedges* NotifyState = NewObject<UANS_UHL_DisableWalkOffLedges>();
+	const FAnimNotifyEventReference EventReference;
+
+	UCharacterMovementComponent* CharacterMovement = Character->GetCharacterMovement();
+	const bool bInitialCanWalkOffLedges = CharacterMovement->bCanWalkOffLedges;
+	NotifyState->NotifyBegin(MeshComp, nullptr, 1.0f, EventReference);
+	TestFalse(TEXT("Walk off ledges disabled"), CharacterMovement->bCanWalkOffLedges);
+	NotifyState->NotifyEnd(MeshComp, nullptr, EventReference);
+	TestTrue(TEXT("Walk off ledges restored"), CharacterMovement->bCanWalkOffLedges == bInitialCanWalkOffLedges);
+
+	const int32 NumAllocations = CountSteadyStateAllocations([&]()
+	{
+		NotifyState->NotifyBegin(MeshComp, nullptr, 1.0f, EventReference);
+		NotifyState->NotifyEnd(MeshComp, nullptr, EventReference);
+	});
+	TestAllocationBudget(*this, TEXT("DisableWalkOffLedges begin/end"), NumAllocations, NotifyBeginEndBudget);
+	return true;
+}
+/** ~Notifies **/
+
+/** Trace helpers **/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUHLOverlapBlockingTestBatchAllocationTest, "UnrealHelperLibrary.Allocations.TraceUtils.OverlapBlockingTestBatchByProfile",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FUHLOverlapBlockingTestBatchAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace UHLAllocationTests;
+
+	const FTestWorld TestWorld;
+	constexpr int32 NumCandidates = 64;
+	constexpr int32 ChunkSize = 32;
+	TArray<FTransform> Candidates;
+	for (int32 i = 0; i < NumCandidates; i++)
+	{
+		Candidates.Add(FTransform(FVector(i * 200.0f, 0.0f, 0.0f)));
+	}
+
+	// out arrays reused between calls like callers are expected to do
+	TBitArray<> ValidMask;
+	TArray<int32> ValidIndices;
+	const FName ProfileName = TEXT("Pawn");
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(UHLAllocationTest), false);
+	const int32 NumValid = UUHLTraceUtilsBPL::OverlapBlockingTestBatchByProfile(TestWorld.World, Candidates, 34.0f, 88.0f,
+		ProfileName, QueryParams, ValidMask, &ValidIndices, 0, ChunkSize);
+	TestEqual(TEXT("All candidates valid in empty world"), NumValid, NumCandidates);
+
+	const int32 NumAllocations = CountSteadyStateAllocations([&]()
+	{
+		UUHLTraceUtilsBPL::OverlapBlockingTestBatchByProfile(TestWorld.World, Candidates, 34.0f, 88.0f,
+			ProfileName, QueryParams, ValidMask, &ValidIndices, 0, ChunkSize);
+	});
+	TestAllocationBudget(*this, TEXT("OverlapBlockingTestBatchByProfile"), NumAllocations,
+		OverlapBlockingTestBatchPerChunkBudget * FMath::DivideAndRoundUp(NumCandidates, ChunkSize));
+	return true;
+}
+/** ~Trace helpers **/
+
+#endif
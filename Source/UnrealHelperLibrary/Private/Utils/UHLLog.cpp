@@ -0,0 +1,47 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+
+#include "Utils/UHLLog.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+
+static float UHLLogRateLimitInterval = 5.0f;
+static FAutoConsoleVariableRef CVarUHLLogRateLimitInterval(
+	TEXT("UHL.Log.RateLimitInterval"),
+	UHLLogRateLimitInterval,
+	TEXT("Seconds between messages logged from same UHL_LOG_RATE_LIMITED call site, others are counted and reported with next message.\n")
+	TEXT("0: rate limiting disabled"),
+	ECVF_Default);
+
+bool FUHLLogRateLimiter::ShouldLog(int32& SuppressedCount_Out)
+{
+	const uint64 NowCycles = FPlatformTime::Cycles64();
+	uint64 ExpectedNextLogCycles = NextLogCycles.load(std::memory_order_relaxed);
+	if (NowCycles < ExpectedNextLogCycles)
+	{
+		SuppressedCount.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	const uint64 IntervalCycles = static_cast<uint64>(FMath::Max(GetInterval(), 0.0f) / FPlatformTime::GetSecondsPerCycle64());
+	// other thread logged in between, count as suppressed
+	if (!NextLogCycles.compare_exchange_strong(ExpectedNextLogCycles, NowCycles + IntervalCycles, std::memory_order_relaxed))
+	{
+		SuppressedCount.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	SuppressedCount_Out = SuppressedCount.exchange(0, std::memory_order_relaxed);
+	return true;
+}
+
+FString FUHLLogRateLimiter::GetSite() const
+{
+	return FString::Printf(TEXT("%s:%d"), *FPaths::GetCleanFilename(ANSI_TO_TCHAR(File)), Line);
+}
+
+float FUHLLogRateLimiter::GetInterval()
+{
+	return UHLLogRateLimitInterval;
+}
@@ -6,6 +6,7 @@
 #include "Engine/EngineTypes.h"
 #include "Engine/HitResult.h"
 #include "DrawDebugHelpers.h"
+#include "Async/ParallelFor.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UHLTraceUtilsBPL)
 
@@ -77,6 +78,70 @@ bool UUHLTraceUtilsBPL::SweepCapsuleMultiByChannel(const UWorld* World, TArray<F
 	return bResult;
 }
 
+int32 UUHLTraceUtilsBPL::OverlapBlockingTestBatchByProfile(const UWorld* World, TConstArrayView<FTransform> Candidates, float Radius, float HalfHeight,
+											  FName ProfileName, const FCollisionQueryParams& QueryParams, TBitArray<>& OutValidMask, TArray<int32>* OutValidIndices,
+											  int32 MaxValid, int32 ChunkSize, bool bDrawDebug, float DrawTime, FColor HitColor)
+{
+	OutValidMask.Reset();
+	if (OutValidIndices)
+	{
+		OutValidIndices->Reset();
+	}
+
+	if (!World || Candidates.IsEmpty())
+	{
+		return 0;
+	}
+
+	const FCollisionShape CollisionShape = FCollisionShape::MakeCapsule(Radius, HalfHeight);
+	ChunkSize = FMath::Max(ChunkSize, 1);
+
+	// scene queries are read-only, safe to run from workers (same as async traces)
+	TArray<bool, TInlineAllocator<64>> ChunkBlocked;
+	int32 NumValid = 0;
+	for (int32 ChunkStart = 0; ChunkStart < Candidates.Num(); ChunkStart += ChunkSize)
+	{
+		const int32 ChunkNum = FMath::Min(ChunkSize, Candidates.Num() - ChunkStart);
+		ChunkBlocked.SetNumUninitialized(ChunkNum, EAllowShrinking::No);
+
+		ParallelFor(ChunkNum, [&](int32 i)
+		{
+			const FTransform& Candidate = Candidates[ChunkStart + i];
+			ChunkBlocked[i] = World->OverlapBlockingTestByProfile(Candidate.GetLocation(), Candidate.GetRotation(), ProfileName, CollisionShape, QueryParams);
+		});
+
+		for (int32 i = 0; i < ChunkNum; i++)
+		{
+			const bool bValid = !ChunkBlocked[i];
+			OutValidMask.Add(bValid);
+			if (!bValid)
+			{
+#if ENABLE_DRAW_DEBUG
+				if (bDrawDebug)
+				{
+					const FTransform& Candidate = Candidates[ChunkStart + i];
+					DrawDebugCapsule(World, Candidate.GetLocation(), HalfHeight, Radius, Candidate.GetRotation(), HitColor, false, DrawTime);
+				}
+#endif
+				continue;
+			}
+
+			NumValid++;
+			if (OutValidIndices && (MaxValid <= 0 || OutValidIndices->Num() < MaxValid))
+			{
+				OutValidIndices->Add(ChunkStart + i);
+			}
+		}
+
+		if (MaxValid > 0 && NumValid >= MaxValid)
+		{
+			break;
+		}
+	}
+
+	return NumValid;
+}
+
 bool UUHLTraceUtilsBPL::SweepCapsuleMultiByProfile(const UWorld* World, TArray<FHitResult>& OutHits, const FVector& Start,
                                                const FVector& End, float Radius, float HalfHeight,
                                                const FQuat& Rot, FName ProfileName,
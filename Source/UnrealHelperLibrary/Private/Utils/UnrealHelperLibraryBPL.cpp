@@ -2,6 +2,7 @@
 
 #include "Utils/UnrealHelperLibraryBPL.h"
 
+#include "UnrealHelperLibrary.h"
 #include "KismetAnimationLibrary.h"
 #include "Components/CapsuleComponent.h"
 #include "Engine/SCS_Node.h"
@@ -20,11 +21,106 @@
 #include "Engine/World.h"
 #include "Engine/GameInstance.h"
 #include "UI/UHLHUD.h"
+#include "Subsystems/GroundHeight/UHLGroundHeightSubsystem.h"
+#include "Subsystems/DebugGraph/UHLDebugGraphSubsystem.h"
+#include "Subsystems/ActorTagIndex/UHLActorTagIndexSubsystem.h"
+#include "Subsystems/NavDistanceField/UHLNavDistanceFieldSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UnrealHelperLibraryBPL)
 
 static const int32 DEPTH_PRIORITY = -1;
 
+namespace UHLBPL
+{
+	float GetDistanceToLocation(const UObject* WorldContextObject, const UUHLNavDistanceFieldSubsystem* NavDistanceField, const FVector& From, const FVector& Location, bool bUseNavigation)
+	{
+		if (!bUseNavigation)
+		{
+			return FVector::Distance(From, Location);
+		}
+
+		// distance field lookup if Location is player's location, otherwise pathfinding
+		float Distance = FLOAT_ERROR;
+		if (!NavDistanceField || !NavDistanceField->GetPathDistanceFromOrigin(Location, From, Distance))
+		{
+			double DistanceInDouble = FLOAT_ERROR;
+			UNavigationSystemV1::GetPathLength(WorldContextObject->GetWorld(), From, Location, DistanceInDouble);
+			Distance = DistanceInDouble;
+		}
+		return Distance;
+	}
+
+	// Shared by GetMostDistantVector/GetMostDistantActorComponent, reads points through GetPoint(Index)
+	// so callers don't have to copy them into temporary array
+	template <typename GetPointType>
+	FVector GetMostDistantPoint(const UObject* WorldContextObject, int32 NumPoints, GetPointType&& GetPoint, FVector Location,
+		float& MaxDistance_Out, int32& Index_Out, bool bUseNavigation, const bool bDebug, const float DebugLifetime)
+	{
+		FVector Result = VECTOR_ERROR;
+		float GreatestDistance = -9999999;
+
+		const UUHLNavDistanceFieldSubsystem* NavDistanceField = bUseNavigation ? UWorld::GetSubsystem<UUHLNavDistanceFieldSubsystem>(WorldContextObject->GetWorld()) : nullptr;
+
+		// distances stored only for debug, so regular calls don't allocate
+		TArray<float> DebugDistances;
+		if (bDebug)
+		{
+			DebugDistances.Reserve(NumPoints);
+		}
+
+		for (int32 i = 0; i < NumPoints; i++)
+		{
+			const FVector Point = GetPoint(i);
+			const float Distance = GetDistanceToLocation(WorldContextObject, NavDistanceField, Point, Location, bUseNavigation);
+			if (bDebug)
+			{
+				DebugDistances.Add(Distance);
+			}
+
+			if (Distance > GreatestDistance)
+			{
+				GreatestDistance = Distance;
+				Result = Point;
+				MaxDistance_Out = Distance;
+				Index_Out = i;
+			}
+		}
+
+		if (bDebug)
+		{
+			for (int32 i = 0; i < NumPoints; i++)
+			{
+				const FVector Point = GetPoint(i);
+				const float Distance = DebugDistances[i];
+				bool bMostDistant = i == Index_Out;
+				DrawDebugLine(WorldContextObject->GetWorld(), Point, Location, bMostDistant ? FColor::Green : FColor::Red, false, DebugLifetime, -1, 2.0f);
+				DrawDebugString(WorldContextObject->GetWorld(), FVector::ZeroVector, FString::Printf(TEXT("Distance: %.2f"), Distance), nullptr, bMostDistant ? FColor::Green : FColor::Red, 0, true, 1);
+			}
+		}
+
+		return Result;
+	}
+
+	AActor* FindAttachedActorByTagRecursive(const AActor* Actor, FName Tag)
+	{
+		AActor* Result = nullptr;
+		Actor->ForEachAttachedActors([&Result, Tag](AActor* AttachedActor)
+		{
+			if (AttachedActor->ActorHasTag(Tag))
+			{
+				Result = AttachedActor;
+			}
+			else
+			{
+				Result = FindAttachedActorByTagRecursive(AttachedActor, Tag);
+			}
+			// stop iterating when found
+			return Result == nullptr;
+		});
+		return Result;
+	}
+}
+
 FString UUnrealHelperLibraryBPL::GetProjectVersion()
 {
 	FString ProjectVersion;
@@ -35,32 +131,37 @@ FString UUnrealHelperLibraryBPL::GetProjectVersion()
 void UUnrealHelperLibraryBPL::DebugPrintStrings(const FString& A, const FString& B, const FString& C, const FString& D, const FString& E, const FString& F, const FString& G, const FString& H,
 	const FString& I, const FString& J, float Duration, const FName Key, const bool bEnabled)
 {
+	if (!bEnabled)
+		return;
+
 	FString StringResult;
-	StringResult.Empty(A.Len() + B.Len() + C.Len() + D.Len() + E.Len() + 1);  // adding one for the string terminator
+	StringResult.Empty(A.Len() + B.Len() + C.Len() + D.Len() + E.Len() + F.Len() + G.Len() + H.Len() + I.Len() + J.Len() + 1);  // adding one for the string terminator
 	StringResult += A;
 	StringResult += B;
 	StringResult += C;
 	StringResult += D;
 	StringResult += E;
-
-	if (!bEnabled)
-		return;
+	StringResult += F;
+	StringResult += G;
+	StringResult += H;
+	StringResult += I;
+	StringResult += J;
 
 	UKismetSystemLibrary::PrintString(nullptr, StringResult, true, true, FLinearColor(0, 0.66, 1), Duration, Key);
 }
 
 void UUnrealHelperLibraryBPL::DebugPrintString(const UObject* WorldContextObject, const FString& A, float Duration, const FName Key, const bool bEnabled)
 {
-	FString StringResult;
-	StringResult.Empty(A.Len() + 1);  // adding one for the string terminator
-
 	if (!bEnabled)
 		return;
 
-	UKismetSystemLibrary::PrintString(WorldContextObject, StringResult, true, true, FLinearColor(0, 0.66, 1), Duration, Key);
+	UKismetSystemLibrary::PrintString(WorldContextObject, A, true, true, FLinearColor(0, 0.66, 1), Duration, Key);
 }
 
-void UUnrealHelperLibraryBPL::DrawDebugBar() {}
+void UUnrealHelperLibraryBPL::DrawDebugBar(const UObject* WorldContextObject, FName MetricName, float Value)
+{
+	UHL_DEBUG_GRAPH_PUSH(WorldContextObject, MetricName, Value);
+}
 
 float UUnrealHelperLibraryBPL::GetAnimMontageSectionLengthByName(UAnimMontage* AnimMontage, FName SectionName)
 {
@@ -275,12 +376,10 @@ AActor* UUnrealHelperLibraryBPL::GetMostDistantActor(const TArray<AActor*>& Acto
 	// TODO use GetMostDistantVector if possible
 	AActor* Result = nullptr;
 	float GreatestDistance = -9999999;
-	TMap<AActor*, float> ActorsAndDistances = {};
 	
 	for (AActor* Actor : Actors)
 	{
 		float Distance = FVector::Distance(Actor->GetActorLocation(), Location);
-		ActorsAndDistances.Add(Actor, Distance);
 		if (Distance > GreatestDistance)
 		{
 			GreatestDistance = Distance;
@@ -291,11 +390,12 @@ AActor* UUnrealHelperLibraryBPL::GetMostDistantActor(const TArray<AActor*>& Acto
 	
 	if (bDebug)
 	{
-		for (const TTuple<AActor*, float>& ActorWithDist : ActorsAndDistances)
+		for (AActor* Actor : Actors)
 		{
-			bool bMostDistant = Result == ActorWithDist.Key;
-			DrawDebugLine(ActorWithDist.Key->GetWorld(), ActorWithDist.Key->GetActorLocation(), Location, bMostDistant ? FColor::Green : FColor::Red, false, DebugLifetime, -1, 2.0f);
-			DrawDebugString(ActorWithDist.Key->GetWorld(), FVector::ZeroVector, FString::Printf(TEXT("Distance: %.2f"), ActorWithDist.Value), ActorWithDist.Key, bMostDistant ? FColor::Green : FColor::Red, 0, true, 1);
+			bool bMostDistant = Result == Actor;
+			float Distance = FVector::Distance(Actor->GetActorLocation(), Location);
+			DrawDebugLine(Actor->GetWorld(), Actor->GetActorLocation(), Location, bMostDistant ? FColor::Green : FColor::Red, false, DebugLifetime, -1, 2.0f);
+			DrawDebugString(Actor->GetWorld(), FVector::ZeroVector, FString::Printf(TEXT("Distance: %.2f"), Distance), Actor, bMostDistant ? FColor::Green : FColor::Red, 0, true, 1);
 		}
 	}
 
@@ -304,73 +404,27 @@ AActor* UUnrealHelperLibraryBPL::GetMostDistantActor(const TArray<AActor*>& Acto
 
 FVector UUnrealHelperLibraryBPL::GetMostDistantVector(
 	const UObject* WorldContextObject,
-	const TArray<FVector> Vectors, FVector Location,
+	const TArray<FVector>& Vectors, FVector Location,
 	float& MaxDistance_Out, int32& Index_Out, bool bUseNavigation,
 	const bool bDebug, const float DebugLifetime)
 {
-	FVector Result = VECTOR_ERROR;
-
-	TArray<float> Distances = {}; 
-	float GreatestDistance = -9999999;
-	
-	for (int32 i = 0; i < Vectors.Num(); i++)
-	{
-		float Distance = FLOAT_ERROR;
-		if (bUseNavigation)
-		{
-			double DistanceInDouble;
-			UNavigationSystemV1::GetPathLength(WorldContextObject->GetWorld(), Vectors[i], Location, DistanceInDouble);
-			Distance = DistanceInDouble;
-		}
-		else
-		{
-			Distance = FVector::Distance(Vectors[i], Location);
-		}
-		
-		Distances[i] = Distance;
-
-		if (Distance > GreatestDistance)
-		{
-			GreatestDistance = Distance;
-			Result = Vectors[i];
-			MaxDistance_Out = Distance;
-			Index_Out = i;
-		}
-	}
-	
-	if (bDebug)
-	{
-		for (int32 i = 0; i < Vectors.Num(); i++)
-		{
-			bool bMostDistant = i == Index_Out;
-			DrawDebugLine(WorldContextObject->GetWorld(), Vectors[i], Location, bMostDistant ? FColor::Green : FColor::Red, false, DebugLifetime, -1, 2.0f);
-			DrawDebugString(WorldContextObject->GetWorld(), FVector::ZeroVector, FString::Printf(TEXT("Distance: %.2f"), Distances[i]), nullptr, bMostDistant ? FColor::Green : FColor::Red, 0, true, 1);
-		}
-	}
-
-	return Result;
+	return UHLBPL::GetMostDistantPoint(WorldContextObject, Vectors.Num(),
+		[&Vectors](int32 Index) { return Vectors[Index]; },
+		Location, MaxDistance_Out, Index_Out, bUseNavigation,
+		bDebug, DebugLifetime);
 }
 
 FVector UUnrealHelperLibraryBPL::GetMostDistantActorComponent(
-	const UObject* WorldContextObject, const TArray<USceneComponent*> SceneComponents,
+	const UObject* WorldContextObject, const TArray<USceneComponent*>& SceneComponents,
 	FVector Location, float& MaxDistance_Out, int32& Index_Out, bool bUseNavigation,
 	const bool bDebug, const float DebugLifetime)
 {
-	TArray<FVector> Vectors = {};
-	for (int32 i = 0; i < SceneComponents.Num(); i++)
-	{
-		if (IsValid(SceneComponents[i]))
+	return UHLBPL::GetMostDistantPoint(WorldContextObject, SceneComponents.Num(),
+		[&SceneComponents](int32 Index)
 		{
-			Vectors.Add(SceneComponents[i]->GetComponentToWorld().GetLocation());
-		}
-		else
-		{
-			Vectors.Add(VECTOR_ERROR);
-		}
-	}
-	return GetMostDistantVector(WorldContextObject,
-		Vectors, Location, 
-		MaxDistance_Out, Index_Out, bUseNavigation,
+			return IsValid(SceneComponents[Index]) ? SceneComponents[Index]->GetComponentToWorld().GetLocation() : VECTOR_ERROR;
+		},
+		Location, MaxDistance_Out, Index_Out, bUseNavigation,
 		bDebug, DebugLifetime);
 }
 
@@ -448,6 +502,19 @@ FVector UUnrealHelperLibraryBPL::GetRandomPointInBox(const USceneComponent* Comp
 	if (bOnGround)
 	{
 		RandomPoint.Z = GetHighestPointInBox(Component).Z;
+
+		// debug draw requires real trace
+		UUHLGroundHeightSubsystem* GroundHeightSubsystem = Component->GetWorld()->GetSubsystem<UUHLGroundHeightSubsystem>();
+		if (!bDrawDebug && GroundHeightSubsystem && GroundHeightSubsystem->CanAnswerTrace(ECC_Visibility))
+		{
+			float GroundHeight = 0.0f;
+			if (GroundHeightSubsystem->GetGroundHeight(RandomPoint, GroundHeight))
+			{
+				RandomPoint.Z = GroundHeight;
+			}
+			return RandomPoint;
+		}
+
 		FHitResult OutHit;
 		UKismetSystemLibrary::LineTraceSingle(Component->GetWorld(), RandomPoint, FVector(0, 0, -999999), TraceTypeQuery1, false, TArray<AActor*>(),
 			bDrawDebug ? EDrawDebugTrace::Type::ForDuration : EDrawDebugTrace::Type::None, OutHit, true, FLinearColor::Red, FLinearColor::Green, DebugDrawTime);
@@ -921,22 +988,23 @@ float UUnrealHelperLibraryBPL::ConvertPercentToMultiplier(float Percent) { retur
 
 AActor* UUnrealHelperLibraryBPL::FindAttachedActorByTag(AActor* ActorIn, FName Tag)
 {
-	TArray<AActor*> OutActors;
-	if (IsValid(ActorIn))
+	if (!IsValid(ActorIn))
 	{
-		ActorIn->GetAttachedActors(OutActors, true, true);
+		return nullptr;
 	}
-	
-	AActor** ActorSearchResult = OutActors.FindByPredicate([Tag](const AActor* Actor)
-	{
-		return Actor->ActorHasTag(Tag);
-	});
 
-	if (ActorSearchResult)
+	// index lookup scales with number of actors having tag, not attachments tree,
+	// misses tags added to AActor::Tags directly after spawn, so fall back to walk
+	if (const UUHLActorTagIndexSubsystem* TagIndexSubsystem = UWorld::GetSubsystem<UUHLActorTagIndexSubsystem>(ActorIn->GetWorld()))
 	{
-		return *ActorSearchResult;
+		if (AActor* IndexedActor = TagIndexSubsystem->FindAttachedActorWithTag(ActorIn, Tag))
+		{
+			return IndexedActor;
+		}
 	}
-	return nullptr;
+
+	// walk attachments in place instead of collecting them into array
+	return UHLBPL::FindAttachedActorByTagRecursive(ActorIn, Tag);
 }
 
 bool UUnrealHelperLibraryBPL::IsPreviewWorld(UObject* WorldContextObject) { return WorldContextObject->GetWorld()->IsPreviewWorld(); }
@@ -953,11 +1021,11 @@ bool UUnrealHelperLibraryBPL::IsObjectInGameWorld(UObject* Object) { return Obje
 
 bool UUnrealHelperLibraryBPL::IsWorldTearingDown(UObject* WorldContextObject) { return WorldContextObject->GetWorld()->bIsTearingDown; }
 
-bool UUnrealHelperLibraryBPL::IsOtherActorInAngle(AActor* Actor, AActor* OtherActor, TArray<FFloatRange> Ranges)
+bool UUnrealHelperLibraryBPL::IsOtherActorInAngle(AActor* Actor, AActor* OtherActor, const TArray<FFloatRange>& Ranges)
 {
 	float RelativeAngle = RelativeAngleToActor(Actor, OtherActor);
 	bool bInAngle = false;
-	for (FFloatRange Range : Ranges)
+	for (const FFloatRange& Range : Ranges)
 	{
 		bInAngle = UKismetMathLibrary::InRange_FloatFloat(RelativeAngle, Range.GetLowerBoundValue(), Range.GetUpperBoundValue(), true, true);
 		if (bInAngle)
@@ -1111,7 +1179,7 @@ void UUnrealHelperLibraryBPL::GetAllStreamingLevels(
 
 	if (!WorldContextObject)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UUnrealHelperLibraryBPL::GetAllStreamingLevels: Invalid WorldContextObject"));
+		UE_LOG(LogUnrealHelperLibrary, Warning, TEXT("UUnrealHelperLibraryBPL::GetAllStreamingLevels: Invalid WorldContextObject"));
 		return;
 	}
 
@@ -1121,7 +1189,7 @@ void UUnrealHelperLibraryBPL::GetAllStreamingLevels(
 
 	if (!World)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UUnrealHelperLibraryBPL::GetAllStreamingLevels: Could not resolve UWorld from context"));
+		UE_LOG(LogUnrealHelperLibrary, Warning, TEXT("UUnrealHelperLibraryBPL::GetAllStreamingLevels: Could not resolve UWorld from context"));
 		return;
 	}
 
@@ -1135,7 +1203,7 @@ void UUnrealHelperLibraryBPL::GetAllSubLevels(UObject* WorldContextObject, TArra
 
 	if (!WorldContextObject)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("GetAllSubLevels: Invalid WorldContextObject"));
+		UE_LOG(LogUnrealHelperLibrary, Warning, TEXT("GetAllSubLevels: Invalid WorldContextObject"));
 		return;
 	}
 
@@ -1146,7 +1214,7 @@ void UUnrealHelperLibraryBPL::GetAllSubLevels(UObject* WorldContextObject, TArra
 
 	if (!World)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("GetAllSubLevels: Could not resolve UWorld from context"));
+		UE_LOG(LogUnrealHelperLibrary, Warning, TEXT("GetAllSubLevels: Could not resolve UWorld from context"));
 		return;
 	}
 
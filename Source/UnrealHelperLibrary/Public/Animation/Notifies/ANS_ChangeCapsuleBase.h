@@ -8,7 +8,7 @@
 #include "Curves/CurveFloat.h"
 #include "CoreMinimal.h"
 #include "AlphaBlend.h"
-#include "Curves/CurveFloat.h"
+#include "Core/UHLBakedCurve.h"
 #include "ANS_ChangeCapsuleBase.generated.h"
 
 USTRUCT(BlueprintType)
@@ -128,19 +128,30 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Change Capsule")
 	FChangeCapsuleCollisionSettings CapsuleCollisionSettings;
 	
+#if WITH_EDITORONLY_DATA
     /**
      * Optional custom Ease Curve:  
      * If you assign a valid FRuntimeFloatCurve here, the raw alpha (from FAlphaBlend)  
      * will be remapped through this curve. If left empty, interpolation uses FAlphaBlend only.
+     * Editor only, baked to "BakedEaseCurve" on load/edit/save, cooked builds get only baked samples
      */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Change Capsule", meta = (DisplayName = "Custom Ease Curve (Optional)"))
+    UPROPERTY(EditAnywhere, Category = "Change Capsule", meta = (DisplayName = "Custom Ease Curve (Optional)"))
     FRuntimeFloatCurve EaseCurve;
+#endif
 
     /** If true, draw a debug visualization of the capsule each tick. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Change Capsule")
     bool bDebug = false;
 
 
+#if WITH_EDITOR
+    virtual void PostLoad() override;
+    virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+    virtual bool SupportsTimelineExecution() const override { return true; };
+
     virtual void NotifyBegin(
         USkeletalMeshComponent* MeshComp,
         UAnimSequenceBase* Animation,
@@ -171,6 +182,14 @@ protected:
 
 
 private:
+    /** EaseCurve sampled over [0, 1], empty if EaseCurve has no keys. */
+    UPROPERTY()
+    FUHLBakedCurve BakedEaseCurve;
+
+#if WITH_EDITOR
+    void BakeEaseCurve();
+#endif
+
     /** The capsule component we’ll modify. */
     UPROPERTY(Transient)
     UCapsuleComponent* CapsuleComp = nullptr;
@@ -202,6 +221,15 @@ private:
     /** Whether we successfully grabbed “originals” in NotifyBegin. */
     bool bHasValidOriginals = false;
 
+    /**
+     * Significance evaluated in NotifyBegin per mesh, line thickness/shape color/debug skipped if false.
+     * Notify object is shared by every mesh playing the animation, so decision is keyed by mesh
+     * and NotifyEnd restores exactly what NotifyBegin applied to that mesh.
+     */
+    TMap<TWeakObjectPtr<const USkeletalMeshComponent>, bool> ApplyCosmeticsByMesh;
+
+    bool ShouldApplyCosmetics(const USkeletalMeshComponent* MeshComp) const;
+
 	/** Snapshot of original capsule settings for revert */
 	FChangeCapsuleCollisionSettings OriginalCapsuleSettings;
 
@@ -35,6 +35,11 @@ public:
 	TEnumAsByte<ECollisionChannel> CollisionChannel = ECC_Pawn;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="EnableRootMotionZAxisMovement", meta=(EditCondition = "bStopMontageIfLandCheckFails", EditConditionHides))
 	FMontageBlendSettings LandCheckBlendOutSettings;
+	// Read ground height from UUHLGroundHeightSubsystem instead of capsule sweep (if cache enabled and
+	// CollisionChannel is in its CacheableTraceChannels, otherwise sweeps as usual),
+	// cheaper but less precise - ground sampled in single point per cell
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="EnableRootMotionZAxisMovement", meta=(EditCondition = "bStopMontageIfLandCheckFails", EditConditionHides))
+	bool bUseGroundHeightCache = false;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category="EnableRootMotionZAxisMovement")
 	bool bDebug = false;
@@ -45,7 +50,9 @@ public:
 #endif
 
     virtual FLinearColor GetEditorColor() override { return FLinearColor(0.0f, 0.74f, 1.0f, 1.0f); };
+#if WITH_EDITOR
     virtual FString GetNotifyName_Implementation() const override { return FString("EnableRootMotionZAxisMovement"); };
+#endif
 
     virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference) override;
 
@@ -54,4 +61,6 @@ public:
 	
 private:
     EMovementMode InitialMovementMode = EMovementMode::MOVE_None;
+
+	void StopRootMotionMontageOnFailedLandCheck(ACharacter* BaseCharacter) const;
 };
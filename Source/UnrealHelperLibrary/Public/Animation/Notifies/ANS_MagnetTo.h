@@ -3,7 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Animation/AnimNotifies/AnimNotifyState.h"
+#include "Animation/Notifies/ANS_UHL_Base.h"
 #include "BehaviorTree/BlackboardData.h"
 #include "ANS_MagnetTo.generated.h"
 
@@ -13,11 +13,13 @@ class ACharacter;
  *
  */
 UCLASS()
-class UNREALHELPERLIBRARY_API UANS_MagnetTo : public UAnimNotifyState
+class UNREALHELPERLIBRARY_API UANS_MagnetTo : public UANS_UHL_Base
 {
 	GENERATED_BODY()
 
 public:
+    UANS_MagnetTo();
+
     // UPROPERTY(Category=Decorator, EditAnywhere)
     // bool bUseBlackboardActor = false;
     UPROPERTY(Category="Decorator", EditAnywhere)
@@ -39,7 +41,11 @@ public:
 #endif
 
     virtual FLinearColor GetEditorColor() override { return FLinearColor(0.0f, 0.74f, 1.0f, 1.0f); };
+#if WITH_EDITOR
     virtual FString GetNotifyName_Implementation() const override { return FString("MagnetTo"); };
+#endif
+
+    virtual bool SupportsTimelineExecution() const override { return true; };
 
     virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference) override;
     virtual void NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float FrameDeltaTime, const FAnimNotifyEventReference& EventReference) override;
@@ -30,7 +30,11 @@ protected:
 #endif
 
     virtual FLinearColor GetEditorColor() override { return FLinearColor(0.799103f, 0.254152f, 0.730461f); };
+#if WITH_EDITOR
     virtual FString GetNotifyName_Implementation() const override;
+#endif
+
+    virtual bool SupportsTimelineExecution() const override { return true; };
 
     virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference) override;
     virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
@@ -5,8 +5,11 @@
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
 #include "Animation/AnimNotifies/AnimNotifyState.h"
+#include "Core/UHLNotifySignificance.h"
 #include "ANS_UHL_Base.generated.h"
 
+class ACharacter;
+class UCharacterMovementComponent;
 class USkeletalMeshComponent;
 
 /**
@@ -22,9 +25,27 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="ANS_UHL_Base")
 	bool bUseOnMontageBlendingOut = true;
 
+	// When cosmetic part of notify should be skipped, e.g. on distant/unrendered meshes
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category="ANS_UHL_Base")
+	FUHLNotifySignificance Significance;
+
+	bool IsMeshSignificant(const USkeletalMeshComponent* MeshComp) const { return Significance.IsSignificant(MeshComp); }
+
 	virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference) override;
 	virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
 
+/** Montage timeline execution **/
+public:
+	// Notify state can be executed by UUHLMontageTimelineExecutorComponent,
+	// engine doesn't dispatch it then (filtered by UUHLAnimInstance)
+	virtual bool SupportsTimelineExecution() const { return false; };
+
+protected:
+	// Taken from executor's shared context when dispatched by timeline
+	ACharacter* GetOwnerCharacter(const USkeletalMeshComponent* MeshComp) const;
+	UCharacterMovementComponent* GetOwnerCharacterMovement(const USkeletalMeshComponent* MeshComp) const;
+/** ~Montage timeline execution **/
+
 /** Experimental **/
 	// Should use experimental features like "NotifyEndOrBlendOut"
 	virtual bool ShouldUseExperimentalUHLFeatures() const { return false; };
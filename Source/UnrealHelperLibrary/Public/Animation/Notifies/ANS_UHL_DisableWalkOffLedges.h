@@ -20,6 +20,8 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ledge Settings")
     float PerchRadiusThreshold = -1.0f;
 
+    virtual bool SupportsTimelineExecution() const override { return true; };
+
     virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference) override;
     virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
 
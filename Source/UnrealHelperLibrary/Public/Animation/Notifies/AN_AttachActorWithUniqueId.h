@@ -30,6 +30,7 @@
  * @param AttachmentTransformRules    Attachment rules
  */
 
+class UUHLAttachmentPropData;
 class UUHLAttachmentTargetEvaluator;
 
 UCLASS()
@@ -38,9 +39,17 @@ class UNREALHELPERLIBRARY_API UAN_AttachActorWithUniqueId : public UAN_UHL_Base
 	GENERATED_BODY()
 
 public:
-	UPROPERTY(EditAnywhere, Category="AttachActorWithUniqueId")
+	UPROPERTY(EditAnywhere, Category="AttachActorWithUniqueId", meta=(EditCondition="!bAttachComponentOnly"))
 	TSoftClassPtr<AActor> ActorToAttach;
 
+	// Attach single mesh component from UUHLAttachmentPropPoolSubsystem instead of spawning actor,
+	// much cheaper for purely visual props. Found by UniqueId with UUHLAttachmentPropPoolSubsystem::FindProp
+	UPROPERTY(EditAnywhere, Category="AttachActorWithUniqueId")
+	bool bAttachComponentOnly = false;
+
+	UPROPERTY(EditAnywhere, Category="AttachActorWithUniqueId", meta=(EditCondition="bAttachComponentOnly", EditConditionHides))
+	TSoftObjectPtr<UUHLAttachmentPropData> PropData;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AttachActorWithUniqueId")
 	FName UniqueId = "Unique_ID";
 
@@ -56,6 +65,11 @@ public:
 	UPROPERTY(EditAnywhere, Category="AttachActorWithUniqueId")
 	FUHLAttachmentRules AttachmentRules;
 
+	// Attached actor is purely visual - don't spawn it on insignificant meshes (see Significance),
+	// don't enable if gameplay code searches for this actor by UniqueId
+	UPROPERTY(EditAnywhere, Category="AttachActorWithUniqueId")
+	bool bCosmeticOnly = false;
+
 protected:
 #if WITH_EDITOR
 	/** Override this to prevent firing this notify state type in animation editors */
@@ -64,8 +78,12 @@ protected:
 #endif
 
 	virtual FLinearColor GetEditorColor() override { return FColor::FromHex("#FF7DE7"); };
+#if WITH_EDITOR
 	virtual FString GetNotifyName_Implementation() const override;
+#endif
 
 	virtual void Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
-	
+
+private:
+	void AttachComponentOnly(USkeletalMeshComponent* MeshComp, AActor* OwnerActor) const;
 };
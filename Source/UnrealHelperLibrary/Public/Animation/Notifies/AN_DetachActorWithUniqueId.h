@@ -50,7 +50,9 @@ protected:
 #endif
 
 	virtual FLinearColor GetEditorColor() override { return FColor::FromHex("#FF7DE7"); };
+#if WITH_EDITOR
 	virtual FString GetNotifyName_Implementation() const override;
+#endif
 
 	virtual void Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
 	
@@ -59,4 +61,6 @@ private:
 	UPROPERTY()
 	FName CollisionProfileName = FName("PhysicsActor");
 	FTimerHandle TimerHandle;
+
+	void DetachProp(USkeletalMeshComponent* MeshComp, AActor* OwnerActor);
 };
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Animation/AnimNotifies/AnimNotify.h"
+#include "Core/UHLNotifySignificance.h"
 #include "AN_UHL_Base.generated.h"
 
 class USkeletalMeshComponent;
@@ -17,4 +18,11 @@ class UNREALHELPERLIBRARY_API UAN_UHL_Base : public UAnimNotify
 public:
     virtual void Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
     FOnNotifySignature OnNotified;
+
+protected:
+	// When cosmetic part of notify should be skipped, e.g. on distant/unrendered meshes
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category="AN_UHL_Base")
+	FUHLNotifySignificance Significance;
+
+	bool IsMeshSignificant(const USkeletalMeshComponent* MeshComp) const { return Significance.IsSignificant(MeshComp); }
 };
@@ -0,0 +1,28 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstance.h"
+#include "UHLAnimInstance.generated.h"
+
+class UUHLMontageTimelineExecutorComponent;
+
+/**
+ * Base anim instance required by UUHLMontageTimelineExecutorComponent,
+ * notify states claimed by executor are filtered out of engine dispatch,
+ * so engine doesn't begin/tick/end them at all.
+ */
+UCLASS()
+class UNREALHELPERLIBRARY_API UUHLAnimInstance : public UAnimInstance
+{
+	GENERATED_BODY()
+
+public:
+	void SetTimelineExecutor(UUHLMontageTimelineExecutorComponent* InTimelineExecutor) { TimelineExecutor = InTimelineExecutor; }
+
+	virtual bool ShouldTriggerAnimNotifyState(const UAnimNotifyState* AnimNotifyState) const override;
+
+private:
+	TWeakObjectPtr<UUHLMontageTimelineExecutorComponent> TimelineExecutor;
+};
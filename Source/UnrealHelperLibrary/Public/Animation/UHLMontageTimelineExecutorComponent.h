@@ -0,0 +1,97 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "UObject/ObjectKey.h"
+#include "UHLMontageTimelineExecutorComponent.generated.h"
+
+class ACharacter;
+class UAnimInstance;
+class UAnimMontage;
+class UANS_UHL_Base;
+class UAnimNotifyState;
+class UCharacterMovementComponent;
+class USkeletalMeshComponent;
+struct FAnimNotifyEvent;
+
+// Shared per-character lookups, resolved once instead of in every notify
+struct FUHLMontageTimelineContext
+{
+	TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+	TWeakObjectPtr<UAnimInstance> AnimInstance;
+	TWeakObjectPtr<ACharacter> Character;
+	TWeakObjectPtr<UCharacterMovementComponent> CharacterMovement;
+};
+
+/**
+ * Executes UHL notify states (that SupportsTimelineExecution) of montages played on owner's mesh.
+ * On montage start all such notify states compiled in time-sorted timeline (cached per montage),
+ * then single component tick runs begin/tick/end of all of them with shared context.
+ * Mesh anim instance must be UUHLAnimInstance, it filters claimed notify states out of engine dispatch,
+ * otherwise executor stays inactive and engine dispatches notify states as usual.
+ *
+ * Active notify states are ended as soon as montage starts blending out.
+ * Notify TriggerChance/filtering/LOD settings are not respected by timeline.
+ */
+UCLASS(ClassGroup=(UnrealHelperLibrary), meta=(BlueprintSpawnableComponent))
+class UNREALHELPERLIBRARY_API UUHLMontageTimelineExecutorComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UUHLMontageTimelineExecutorComponent();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// Context of timeline currently dispatching notify, nullptr if notify called by engine
+	static const FUHLMontageTimelineContext* GetDispatchingContext() { return DispatchingContext; }
+
+	// Notify state is executed by this component, engine shouldn't dispatch it
+	bool ClaimsNotifyState(const UAnimNotifyState* NotifyState) const { return ClaimedNotifyStates.Contains(NotifyState); }
+	const FUHLMontageTimelineContext& GetContext() const { return Context; }
+
+private:
+	struct FCompiledNotifyState
+	{
+		// index in Montage->Notifies, array can be reallocated so event isn't kept by pointer
+		TWeakObjectPtr<UAnimMontage> Montage;
+		int32 NotifyIndex = INDEX_NONE;
+		// only compared with event's notify state to validate index
+		const UANS_UHL_Base* NotifyState = nullptr;
+		float StartTime = 0.0f;
+		float EndTime = 0.0f;
+	};
+
+	struct FRunningMontage
+	{
+		TWeakObjectPtr<UAnimMontage> Montage;
+		TBitArray<> ActiveNotifyStates;
+		float PreviousPosition = 0.0f;
+	};
+
+	FUHLMontageTimelineContext Context;
+
+	TMap<TObjectKey<UAnimMontage>, TArray<FCompiledNotifyState>> CompiledTimelines;
+	TArray<FRunningMontage> RunningMontages;
+	TSet<TObjectKey<UAnimNotifyState>> ClaimedNotifyStates;
+
+	static const FUHLMontageTimelineContext* DispatchingContext;
+
+	void CompileTimeline(UAnimMontage* Montage);
+	void TickRunningMontage(FRunningMontage& RunningMontage, const TArray<FCompiledNotifyState>& Timeline, float Position, float DeltaTime);
+	void EndRunningMontage(FRunningMontage& RunningMontage);
+	static const FAnimNotifyEvent* GetNotifyEvent(const FCompiledNotifyState& CompiledNotifyState);
+
+	void DispatchBegin(const FCompiledNotifyState& CompiledNotifyState, UAnimMontage* Montage);
+	void DispatchTick(const FCompiledNotifyState& CompiledNotifyState, UAnimMontage* Montage, float DeltaTime);
+	void DispatchEnd(const FCompiledNotifyState& CompiledNotifyState, UAnimMontage* Montage);
+
+	UFUNCTION()
+	void OnMontageStarted(UAnimMontage* Montage);
+	UFUNCTION()
+	void OnMontageEnded(UAnimMontage* Montage, bool bInterrupted);
+};
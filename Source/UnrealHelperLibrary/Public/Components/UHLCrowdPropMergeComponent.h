@@ -0,0 +1,95 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Subsystems/EnemyTickManager/EnemyTickOptimizerSubsystem.h"
+#include "UHLCrowdPropMergeComponent.generated.h"
+
+class UMeshComponent;
+class USkeletalMesh;
+class USkeletalMeshComponent;
+class UStaticMesh;
+class UStaticMeshComponent;
+
+/**
+ * Merges props attached to owner's mesh (actors from AN_AttachActorWithUniqueId, pooled prop components)
+ * to reduce draw calls of crowd enemies:
+ * - static props attached to same socket merged in single static mesh, sections with same material merged
+ * - skeletal props sharing owner's skeleton merged by FSkeletalMeshMerge and driven by leader pose
+ *
+ * Merge happens when attachments didn't change for "SettleTime" and enemy is in "MinMergeTier" or farther,
+ * originals are hidden, not destroyed. Restored on promotion or when attachments change.
+ * Merged meshes are cached in UUHLCrowdPropMergeCacheSubsystem and shared between enemies with same props.
+ *
+ * Source meshes must have "Allow CPU Access" enabled, otherwise they are left unmerged
+ */
+UCLASS(ClassGroup=(UnrealHelperLibrary), meta=(BlueprintSpawnableComponent))
+class UNREALHELPERLIBRARY_API UUHLCrowdPropMergeComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UUHLCrowdPropMergeComponent();
+
+	// If disabled, props merged right after they settle regardless of distance
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="CrowdPropMerge")
+	bool bMergeOnlyInFarTiers = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="CrowdPropMerge", meta=(EditCondition="bMergeOnlyInFarTiers"))
+	EEnemyTickOptimizerTier MinMergeTier = EEnemyTickOptimizerTier::Far;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="CrowdPropMerge", meta=(ClampMin="0.0", Units="Seconds"))
+	float SettleTime = 1.0f;
+
+	// LOD of static props used for merged mesh, merged meshes mostly visible from far
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="CrowdPropMerge", meta=(ClampMin="0"))
+	int32 StaticMeshLODIndex = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="CrowdPropMerge")
+	bool bMergeSkeletalProps = true;
+
+	UFUNCTION(BlueprintCallable, Category="CrowdPropMerge")
+	void MergeProps();
+	// Shows original props again, called by attach/detach notifies before changing attachments
+	UFUNCTION(BlueprintCallable, Category="CrowdPropMerge")
+	void RestoreProps();
+
+	UFUNCTION(BlueprintPure, Category="CrowdPropMerge")
+	bool IsMerged() const { return bMerged; }
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	struct FStaticPropGroup
+	{
+		FName SocketName;
+		TArray<UStaticMeshComponent*> Components;
+	};
+
+	TWeakObjectPtr<USkeletalMeshComponent> OwnerMesh;
+	bool bMerged = false;
+	bool bInMergeTier = false;
+
+	// attachments hash from last check, merge when it stays same for SettleTime
+	uint32 PropsSignature = 0;
+	double PropsSignatureTime = 0.0;
+	FTimerHandle SettleCheckTimerHandle;
+	FDelegateHandle TierChangedHandle;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UMeshComponent>> MergedComponents;
+	TArray<TWeakObjectPtr<UMeshComponent>> HiddenComponents;
+
+	void GatherProps(TArray<FStaticPropGroup>& OutStaticGroups, TArray<USkeletalMeshComponent*>& OutSkeletalProps) const;
+	uint32 CalculatePropsSignature() const;
+	void CheckPropsSettled();
+
+	UStaticMesh* GetOrBuildMergedStaticMesh(const FStaticPropGroup& Group, const FTransform& SocketTransform) const;
+	USkeletalMesh* GetOrBuildMergedSkeletalMesh(const TArray<USkeletalMeshComponent*>& SkeletalProps) const;
+
+	void OnTierChanged(ACharacter* Enemy, EEnemyTickOptimizerTier OldTier, EEnemyTickOptimizerTier NewTier);
+};
@@ -0,0 +1,124 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "UnrealHelperLibraryTypes.h"
+#include "Subsystems/EnemyTickManager/EnemyTickOptimizerSubsystem.h"
+#include "UHLLocomotionDirectionCacheComponent.generated.h"
+
+USTRUCT(BlueprintType)
+struct FUHLLocomotionDirectionSnapshot
+{
+	GENERATED_BODY()
+
+	// Owner's movement direction relative to its own facing
+	UPROPERTY(BlueprintReadOnly, Category = "LocomotionDirection")
+	EUHLDirection MovementDirection = EUHLDirection::None;
+
+	// Owner's movement relative to "RelativeToActor" facing, compensating its velocity
+	UPROPERTY(BlueprintReadOnly, Category = "LocomotionDirection")
+	EUHLDirection DirectionRelativeToActor = EUHLDirection::None;
+
+	// Signed yaw between velocity and owner's forward [-180, 180], 0 when not moving
+	UPROPERTY(BlueprintReadOnly, Category = "LocomotionDirection")
+	float RelativeAngle = 0.0f;
+
+	// Horizontal speed
+	UPROPERTY(BlueprintReadOnly, Category = "LocomotionDirection")
+	float Speed = 0.0f;
+
+	// Index of first SpeedBucketThresholds entry greater than Speed, 0 - idle
+	UPROPERTY(BlueprintReadOnly, Category = "LocomotionDirection")
+	int32 SpeedBucket = 0;
+
+	// World time of computation
+	UPROPERTY(BlueprintReadOnly, Category = "LocomotionDirection")
+	float UpdateTime = -1.0f;
+};
+
+/**
+ * Computes locomotion direction values once per update and shares them between
+ * AnimBPs, AI and other consumers instead of each calling GetMovementDirection /
+ * GetEnemyMovementDirectionRelativeToCharacter every frame.
+ *
+ * Update rate follows UEnemyTickOptimizerSubsystem tier of owner, getters are thread safe
+ * so they can be used from anim thread (BlueprintThreadSafe).
+ */
+UCLASS(ClassGroup=(UnrealHelperLibrary), meta=(BlueprintSpawnableComponent))
+class UNREALHELPERLIBRARY_API UUHLLocomotionDirectionCacheComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UUHLLocomotionDirectionCacheComponent();
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="LocomotionDirection")
+	float DeadZone = 10.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="LocomotionDirection")
+	float AngleToleranceDeg = 5.0f;
+
+	// Collapse diagonals into nearest cardinal direction
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="LocomotionDirection")
+	bool bFourWay = false;
+
+	// Ascending, e.g. walk/jog/run speeds
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="LocomotionDirection")
+	TArray<float> SpeedBucketThresholds = { 10.0f, 200.0f, 450.0f };
+
+	// If RelativeToActor not set, player character used
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="LocomotionDirection")
+	bool bRelativeToPlayerByDefault = true;
+
+	/** Update intervals by tier, owner not registered in optimizer uses Close **/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="LocomotionDirection|UpdateRate", meta=(ClampMin="0.0", Units="Seconds"))
+	float CloseUpdateInterval = 0.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="LocomotionDirection|UpdateRate", meta=(ClampMin="0.0", Units="Seconds"))
+	float MediumUpdateInterval = 0.1f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="LocomotionDirection|UpdateRate", meta=(ClampMin="0.0", Units="Seconds"))
+	float FarUpdateInterval = 0.25f;
+	// OutOfRange and NotRendered
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="LocomotionDirection|UpdateRate", meta=(ClampMin="0.0", Units="Seconds"))
+	float HiddenUpdateInterval = 0.5f;
+	/** ~Update intervals by tier **/
+
+	UFUNCTION(BlueprintCallable, Category="LocomotionDirection")
+	void SetRelativeToActor(AActor* Actor) { RelativeToActor = Actor; }
+
+	// Recompute right now regardless of update interval
+	UFUNCTION(BlueprintCallable, Category="LocomotionDirection")
+	void ForceUpdate();
+
+	/** Thread safe getters **/
+	UFUNCTION(BlueprintPure, Category="LocomotionDirection", meta=(BlueprintThreadSafe))
+	FUHLLocomotionDirectionSnapshot GetSnapshot() const;
+	UFUNCTION(BlueprintPure, Category="LocomotionDirection", meta=(BlueprintThreadSafe))
+	EUHLDirection GetMovementDirection() const;
+	UFUNCTION(BlueprintPure, Category="LocomotionDirection", meta=(BlueprintThreadSafe))
+	EUHLDirection GetDirectionRelativeToActor() const;
+	UFUNCTION(BlueprintPure, Category="LocomotionDirection", meta=(BlueprintThreadSafe))
+	float GetRelativeAngle() const;
+	UFUNCTION(BlueprintPure, Category="LocomotionDirection", meta=(BlueprintThreadSafe))
+	int32 GetSpeedBucket() const;
+	/** ~Thread safe getters **/
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+	UPROPERTY(Transient)
+	TWeakObjectPtr<AActor> RelativeToActor;
+
+	mutable FRWLock SnapshotLock;
+	FUHLLocomotionDirectionSnapshot Snapshot;
+
+	EEnemyTickOptimizerTier Tier = EEnemyTickOptimizerTier::Close;
+	FDelegateHandle TierChangedHandle;
+
+	float GetUpdateInterval() const;
+	void OnTierChanged(ACharacter* Enemy, EEnemyTickOptimizerTier OldTier, EEnemyTickOptimizerTier NewTier);
+};
@@ -0,0 +1,84 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Subsystems/EnemyTickManager/EnemyTickOptimizerSubsystem.h"
+#include "UHLTickSmoothingComponent.generated.h"
+
+UENUM(BlueprintType)
+enum class EUHLTickSmoothingMode : uint8
+{
+	// Smooth but visually one simulation tick behind capsule
+	Interpolate,
+	// Predicts from last velocity, no lag but may overshoot on stops/turns
+	Extrapolate,
+};
+
+/**
+ * Hides movement stepping of enemies ticked with reduced interval by UEnemyTickOptimizerSubsystem.
+ * Capsule stays authoritative, only owner's mesh is offset every frame between simulation ticks,
+ * same idea as CharacterMovementComponent network smoothing for simulated proxies.
+ *
+ * Active only while owner is in "MinSmoothedTier" or farther, ticks every frame and
+ * optimizer doesn't change its tick interval. Not applied on simulated proxies,
+ * they are smoothed by movement component already.
+ */
+UCLASS(ClassGroup=(UnrealHelperLibrary), meta=(BlueprintSpawnableComponent))
+class UNREALHELPERLIBRARY_API UUHLTickSmoothingComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UUHLTickSmoothingComponent();
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="TickSmoothing")
+	EUHLTickSmoothingMode Mode = EUHLTickSmoothingMode::Interpolate;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="TickSmoothing")
+	EEnemyTickOptimizerTier MinSmoothedTier = EEnemyTickOptimizerTier::Medium;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="TickSmoothing", meta=(ClampMin="0.0", Units="Seconds", EditCondition="Mode == EUHLTickSmoothingMode::Extrapolate"))
+	float MaxExtrapolationTime = 0.5f;
+
+	// Capsule moved farther than this between simulation ticks is treated as teleport, mesh snaps
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="TickSmoothing", meta=(ClampMin="0.0", Units="Centimeters"))
+	float TeleportDistance = 500.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="TickSmoothing")
+	bool bSmoothRotation = true;
+
+	UFUNCTION(BlueprintPure, Category="TickSmoothing")
+	bool IsSmoothing() const { return bSmoothing; }
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+	struct FSample
+	{
+		FVector Location = FVector::ZeroVector;
+		FQuat Rotation = FQuat::Identity;
+		double Time = 0.0;
+	};
+
+	TWeakObjectPtr<USceneComponent> Mesh;
+	// only for non-Character owners, Character base offsets are read every frame,
+	// they may change at runtime (crouch, mesh offset adjustments)
+	FVector MeshBaseLocation = FVector::ZeroVector;
+	FQuat MeshBaseRotation = FQuat::Identity;
+
+	FSample PreviousSample;
+	FSample LastSample;
+	bool bSmoothing = false;
+	FDelegateHandle TierChangedHandle;
+
+	void SetSmoothing(bool bEnable);
+	void ResetSamples();
+	void RestoreMesh();
+	void GetMeshBase(FVector& OutLocation, FQuat& OutRotation) const;
+	void OnTierChanged(ACharacter* Enemy, EEnemyTickOptimizerTier OldTier, EEnemyTickOptimizerTier NewTier);
+};
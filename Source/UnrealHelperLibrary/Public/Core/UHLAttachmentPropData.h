@@ -0,0 +1,45 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "UHLAttachmentPropData.generated.h"
+
+class UMaterialInterface;
+class USkeletalMesh;
+class UStaticMesh;
+
+/**
+ * Lightweight visual prop (sword, shield...) attached as single mesh component,
+ * without spawning actor. Used by AN_AttachActorWithUniqueId with "bAttachComponentOnly"
+ */
+UCLASS(BlueprintType)
+class UNREALHELPERLIBRARY_API UUHLAttachmentPropData : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// StaticMesh used if set, otherwise SkeletalMesh
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AttachmentProp")
+	TSoftObjectPtr<UStaticMesh> StaticMesh;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AttachmentProp")
+	TSoftObjectPtr<USkeletalMesh> SkeletalMesh;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AttachmentProp")
+	TArray<TSoftObjectPtr<UMaterialInterface>> OverrideMaterials;
+
+	// Applied after attachment
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AttachmentProp")
+	FTransform RelativeTransform = FTransform::Identity;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AttachmentProp")
+	bool bCastShadow = true;
+
+	// Cosmetic props usually don't need collision
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AttachmentProp")
+	FName CollisionProfileName = FName("NoCollision");
+
+	bool IsSkeletal() const { return StaticMesh.IsNull() && !SkeletalMesh.IsNull(); }
+};
@@ -0,0 +1,32 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UHLBakedCurve.generated.h"
+
+struct FRichCurve;
+
+/**
+ * Curve over [0, 1] baked in editor to evenly spaced samples.
+ * Used instead of editor-only FRuntimeFloatCurve in cooked data,
+ * empty curves cost only empty array.
+ */
+USTRUCT()
+struct UNREALHELPERLIBRARY_API FUHLBakedCurve
+{
+	GENERATED_BODY()
+
+	static constexpr int32 DefaultNumSamples = 33;
+
+	bool IsEmpty() const { return Samples.IsEmpty(); }
+	// Linear interpolation between samples, Time clamped to [0, 1]
+	float Eval(float Time) const;
+
+	// Empty or null curve clears samples
+	void Bake(const FRichCurve* Curve, int32 NumSamples = DefaultNumSamples);
+
+private:
+	UPROPERTY()
+	TArray<float> Samples;
+};
@@ -0,0 +1,45 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UHLNotifySignificance.generated.h"
+
+class USkeletalMeshComponent;
+
+UENUM(BlueprintType)
+enum class EUHLNotifySignificancePolicy : uint8
+{
+	// Always do full work
+	Always,
+	// Never do cosmetic work, only gameplay-critical state applied
+	GameplayCriticalOnly,
+	// Skip cosmetic work if mesh wasn't rendered recently
+	SkipWhenNotRendered,
+	// Skip cosmetic work if mesh is farther than MaxDistance from local camera
+	SkipBeyondDistance,
+	SkipWhenNotRenderedOrBeyondDistance,
+};
+
+/**
+ * Decides if notify should do cosmetic work (debug draw, VFX props, visual lerps) on mesh.
+ * Gameplay-critical state is applied by notifies regardless of significance.
+ */
+USTRUCT(BlueprintType)
+struct UNREALHELPERLIBRARY_API FUHLNotifySignificance
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Significance")
+	EUHLNotifySignificancePolicy Policy = EUHLNotifySignificancePolicy::Always;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Significance", meta=(ClampMin="0.0", Units="Centimeters",
+		EditCondition="Policy == EUHLNotifySignificancePolicy::SkipBeyondDistance || Policy == EUHLNotifySignificancePolicy::SkipWhenNotRenderedOrBeyondDistance"))
+	float MaxDistance = 5000.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Significance", meta=(ClampMin="0.0", Units="Seconds",
+		EditCondition="Policy == EUHLNotifySignificancePolicy::SkipWhenNotRendered || Policy == EUHLNotifySignificancePolicy::SkipWhenNotRenderedOrBeyondDistance"))
+	float RenderedRecentlyTolerance = 0.2f;
+
+	bool IsSignificant(const USkeletalMeshComponent* MeshComp) const;
+};
@@ -5,6 +5,13 @@
 #include "CoreMinimal.h"
 #include "Engine/DeveloperSettings.h"
 #include "Subsystems/EnemyTickManager/EnemyTickOptimizerSubsystem.h"
+#include "Subsystems/GroundHeight/UHLGroundHeightSubsystem.h"
+#include "Subsystems/LineOfSight/UHLLineOfSightCacheSubsystem.h"
+#include "Subsystems/AttachmentPropPool/UHLAttachmentPropPoolSubsystem.h"
+#include "Subsystems/DebugGraph/UHLDebugGraphSubsystem.h"
+#include "Subsystems/ArchetypePreload/UHLArchetypePreloadSubsystem.h"
+#include "Subsystems/ActorTagIndex/UHLActorTagIndexSubsystem.h"
+#include "Subsystems/NavDistanceField/UHLNavDistanceFieldSubsystem.h"
 #include "UHLSettings.generated.h"
 
 /**
@@ -18,6 +25,33 @@ class UNREALHELPERLIBRARY_API UUHLSettings : public UDeveloperSettings
 public:
 	UPROPERTY(config, EditAnywhere, Category="EnemyTickOptimizerSubsystemSettings")
 	FEnemyTickOptimizerSubsystemSettings EnemyTickOptimizerSubsystemSettings;
+
+	// First matching override replaces EnemyTickOptimizerSubsystemSettings, re-selected when scalability changes
+	UPROPERTY(config, EditAnywhere, Category="EnemyTickOptimizerSubsystemSettings")
+	TArray<FEnemyTickOptimizerSettingsOverride> EnemyTickOptimizerSettingsOverrides;
+
+	UPROPERTY(config, EditAnywhere, Category="GroundHeightSubsystemSettings")
+	FUHLGroundHeightSubsystemSettings GroundHeightSubsystemSettings;
+
+	UPROPERTY(config, EditAnywhere, Category="LineOfSightCacheSettings")
+	FUHLLineOfSightCacheSettings LineOfSightCacheSettings;
+
+	UPROPERTY(config, EditAnywhere, Category="AttachmentPropPoolSettings")
+	FUHLAttachmentPropPoolSettings AttachmentPropPoolSettings;
+
+	UPROPERTY(config, EditAnywhere, Category="DebugGraphSettings")
+	FUHLDebugGraphSettings DebugGraphSettings;
+
+	UPROPERTY(config, EditAnywhere, Category="ArchetypePreloadSettings")
+	FUHLArchetypePreloadSettings ArchetypePreloadSettings;
+
+	UPROPERTY(config, EditAnywhere, Category="ActorTagIndexSettings")
+	FUHLActorTagIndexSettings ActorTagIndexSettings;
+
+	UPROPERTY(config, EditAnywhere, Category="NavDistanceFieldSettings")
+	FUHLNavDistanceFieldSettings NavDistanceFieldSettings;
+
+	const FEnemyTickOptimizerSubsystemSettings& GetEnemyTickOptimizerSettings(const Scalability::FQualityLevels& QualityLevels) const;
 	
 protected:
 //~UDeveloperSettings interface
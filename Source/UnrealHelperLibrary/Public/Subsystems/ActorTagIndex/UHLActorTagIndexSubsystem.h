@@ -0,0 +1,97 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "UHLActorTagIndexSubsystem.generated.h"
+
+USTRUCT(BlueprintType)
+struct FUHLActorTagIndexSettings
+{
+	GENERATED_BODY()
+
+	// If disabled subsystem isn't created, FindAttachedActorByTag walks attachments instead
+	UPROPERTY(EditAnywhere, Category = "Actor Tag Index")
+	bool bEnable = true;
+
+	// Also index owned gameplay tags of actors implementing IGameplayTagAssetInterface,
+	// they change at runtime so call UpdateActorTags after changing them
+	UPROPERTY(EditAnywhere, Category = "Actor Tag Index")
+	bool bIndexGameplayTags = true;
+};
+
+/**
+ * Actors by AActor::Tags (and gameplay tags) lookup without iterating whole world
+ * like UGameplayStatics::GetAllActorsWithTag does, queries cost depends only on result size.
+ *
+ * Index updated on spawn/destroy and streaming level add/remove.
+ * AActor::Tags is plain array, so tags changed after spawn should go through
+ * AddActorTag/RemoveActorTag or be followed by UpdateActorTags call.
+ */
+UCLASS()
+class UNREALHELPERLIBRARY_API UUHLActorTagIndexSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Queries, OutActors is Reset() - reuse same array to avoid allocations **/
+	UFUNCTION(BlueprintCallable, Category = "UHL|ActorTagIndex")
+	void GetActorsWithTag(FName Tag, TArray<AActor*>& OutActors) const;
+	// Non-exact also matches actors with child tags, e.g. "Enemy" matches "Enemy.Melee"
+	UFUNCTION(BlueprintCallable, Category = "UHL|ActorTagIndex")
+	void GetActorsWithGameplayTag(FGameplayTag GameplayTag, bool bExactMatch, TArray<AActor*>& OutActors) const;
+	UFUNCTION(BlueprintPure, Category = "UHL|ActorTagIndex")
+	AActor* FindActorWithTag(FName Tag) const;
+	// Actor with tag attached to Parent directly or through other attached actors
+	UFUNCTION(BlueprintPure, Category = "UHL|ActorTagIndex")
+	AActor* FindAttachedActorWithTag(const AActor* Parent, FName Tag) const;
+	/** ~Queries **/
+
+	UFUNCTION(BlueprintCallable, Category = "UHL|ActorTagIndex")
+	void AddActorTag(AActor* Actor, FName Tag);
+	UFUNCTION(BlueprintCallable, Category = "UHL|ActorTagIndex")
+	void RemoveActorTag(AActor* Actor, FName Tag);
+	// Re-reads actor tags, call after changing AActor::Tags or gameplay tags directly
+	UFUNCTION(BlueprintCallable, Category = "UHL|ActorTagIndex")
+	void UpdateActorTags(AActor* Actor);
+
+	int32 GetNumIndexedActors() const { return IndexedActors.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FIndexedActor
+	{
+		TArray<FName> Tags;
+		// exact owned tags, buckets also include their parents
+		FGameplayTagContainer GameplayTags;
+	};
+
+	FUHLActorTagIndexSettings Settings;
+
+	TMap<TObjectKey<AActor>, FIndexedActor> IndexedActors;
+	TMap<FName, TArray<TWeakObjectPtr<AActor>>> ActorsByTag;
+	TMap<FGameplayTag, TArray<TWeakObjectPtr<AActor>>> ActorsByGameplayTag;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+
+	void AddActor(AActor* Actor);
+	void RemoveActor(AActor* Actor);
+
+	void OnActorSpawned(AActor* Actor);
+	void OnActorDestroyed(AActor* Actor);
+	void OnLevelAdded(ULevel* Level, UWorld* World);
+	void OnLevelRemoved(ULevel* Level, UWorld* World);
+};
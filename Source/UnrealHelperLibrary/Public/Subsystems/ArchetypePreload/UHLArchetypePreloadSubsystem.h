@@ -0,0 +1,125 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UHLArchetypePreloadSubsystem.generated.h"
+
+struct FStreamableHandle;
+
+USTRUCT(BlueprintType)
+struct FUHLArchetypePreloadSettings
+{
+	GENERATED_BODY()
+
+	// Estimated by packages size on disk * DiskSizeToMemoryScale, preloads above budget wait in queue.
+	// Rough estimate, compare with "memreport" of loaded archetypes to tune scale
+	UPROPERTY(EditAnywhere, Category = "Archetype Preload", meta = (ClampMin = "0", Units = "Megabytes"))
+	int32 MemoryBudgetMB = 512;
+
+	// Disk size is compressed, loaded assets usually take more memory
+	UPROPERTY(EditAnywhere, Category = "Archetype Preload", meta = (ClampMin = "0.1"))
+	float DiskSizeToMemoryScale = 2.0f;
+
+	// Used for packages without size in asset registry, cooked asset registry often strips package data
+	UPROPERTY(EditAnywhere, Category = "Archetype Preload", meta = (ClampMin = "0", Units = "Kilobytes"))
+	int32 FallbackPackageSizeKB = 256;
+
+	// Lower priority preloads unloaded and re-queued to fit new preload into budget
+	UPROPERTY(EditAnywhere, Category = "Archetype Preload")
+	bool bEvictLowerPriority = true;
+
+	// How deep soft references (e.g. notify's ActorToAttach, ability classes) are followed.
+	// Hard references always loaded with archetype
+	UPROPERTY(EditAnywhere, Category = "Archetype Preload", meta = (ClampMin = "0", ClampMax = "4"))
+	int32 SoftReferenceDepth = 1;
+
+	// Bundles loaded for primary data assets if preload doesn't specify own
+	UPROPERTY(EditAnywhere, Category = "Archetype Preload")
+	TArray<FName> DefaultBundles;
+};
+
+UENUM(BlueprintType)
+enum class EUHLArchetypePreloadState : uint8
+{
+	None,
+	// Waiting for memory budget
+	Queued,
+	Loading,
+	Ready,
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnUHLArchetypePreloadReady, FName, PreloadId);
+
+/**
+ * Warms enemy archetypes before they're spawned, e.g. before encounter wave.
+ *
+ * Archetype classes and data assets resolved to packages including soft references
+ * up to "SoftReferenceDepth", primary data assets also add assets from their bundles.
+ * Everything streamed asynchronously with priority, kept loaded until ReleasePreload.
+ *
+ * Memory budget uses package disk sizes from asset registry, it's estimation.
+ * In cooked builds dependencies available only if asset registry keeps them,
+ * otherwise only archetypes themselves and their hard references loaded.
+ */
+UCLASS()
+class UNREALHELPERLIBRARY_API UUHLArchetypePreloadSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	UPROPERTY(BlueprintAssignable, Category = "UHL|ArchetypePreload")
+	FOnUHLArchetypePreloadReady OnPreloadReady;
+
+	/**
+	 * Preload with same PreloadId is replaced.
+	 * @param Priority higher loads first and may evict lower priority preloads
+	 * @param Bundles for primary data assets, empty - DefaultBundles from settings
+	 */
+	UFUNCTION(BlueprintCallable, Category = "UHL|ArchetypePreload", meta = (AutoCreateRefTerm = "Bundles"))
+	void PreloadArchetypes(FName PreloadId, const TArray<TSoftClassPtr<UObject>>& ArchetypeClasses, const TArray<TSoftObjectPtr<UObject>>& ArchetypeAssets,
+		int32 Priority, const TArray<FName>& Bundles);
+
+	UFUNCTION(BlueprintCallable, Category = "UHL|ArchetypePreload")
+	void ReleasePreload(FName PreloadId);
+
+	UFUNCTION(BlueprintPure, Category = "UHL|ArchetypePreload")
+	EUHLArchetypePreloadState GetPreloadState(FName PreloadId) const;
+
+	UFUNCTION(BlueprintPure, Category = "UHL|ArchetypePreload")
+	bool IsPreloadReady(FName PreloadId) const { return GetPreloadState(PreloadId) == EUHLArchetypePreloadState::Ready; }
+
+	// [0, 1], 0 while queued
+	UFUNCTION(BlueprintPure, Category = "UHL|ArchetypePreload")
+	float GetPreloadProgress(FName PreloadId) const;
+
+	UFUNCTION(BlueprintPure, Category = "UHL|ArchetypePreload")
+	float GetUsedBudgetMB() const { return UsedBudgetBytes / (1024.0f * 1024.0f); }
+
+private:
+	struct FPreload
+	{
+		FName Id;
+		int32 Priority = 0;
+		EUHLArchetypePreloadState State = EUHLArchetypePreloadState::None;
+		int64 EstimatedSize = 0;
+
+		TArray<FSoftObjectPath> Paths;
+		TSharedPtr<FStreamableHandle> Handle;
+	};
+
+	FUHLArchetypePreloadSettings Settings;
+	TMap<FName, FPreload> Preloads;
+	int64 UsedBudgetBytes = 0;
+
+	void ResolveDependencies(FPreload& Preload, const TArray<FSoftObjectPath>& RootPaths, const TArray<FName>& Bundles) const;
+	void StartQueuedPreloads();
+	bool TryFreeBudget(int64 RequiredBytes, int32 Priority);
+	void StartPreload(FPreload& Preload);
+	void OnPreloadHandleCompleted(FName PreloadId);
+	void CancelPreload(FPreload& Preload);
+};
@@ -0,0 +1,104 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Engine/TimerHandle.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "UHLAttachmentPropPoolSubsystem.generated.h"
+
+class UMeshComponent;
+class USceneComponent;
+class UUHLAttachmentPropData;
+
+USTRUCT(BlueprintType)
+struct FUHLAttachmentPropPoolSettings
+{
+	GENERATED_BODY()
+
+	// Released components above this count are destroyed instead of pooled
+	UPROPERTY(EditAnywhere, Category = "Attachment Prop Pool", meta = (ClampMin = "0"))
+	int32 MaxFreeComponents = 64;
+};
+
+/**
+ * Creates/reuses mesh components for UUHLAttachmentPropData props,
+ * props addressable by (Owner, UniqueId) same as actors attached by AN_AttachActorWithUniqueId.
+ *
+ * Components owned by single hidden pool actor, so attaching prop doesn't register actor,
+ * call BeginPlay or add replication checks. Props are released automatically when owner ends play.
+ */
+UCLASS()
+class UNREALHELPERLIBRARY_API UUHLAttachmentPropPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Prop with same UniqueId already attached to Owner is released first
+	UFUNCTION(BlueprintCallable, Category = "UHL|AttachmentPropPool")
+	UMeshComponent* AttachProp(AActor* Owner, const UUHLAttachmentPropData* PropData, USceneComponent* AttachParent, FName SocketName, FName UniqueId, EAttachmentRule AttachmentRule = EAttachmentRule::SnapToTarget);
+
+	UFUNCTION(BlueprintCallable, Category = "UHL|AttachmentPropPool")
+	UMeshComponent* FindProp(const AActor* Owner, FName UniqueId) const;
+
+	// Detaches prop but keeps it addressable, e.g. to drop it with physics, release later
+	UFUNCTION(BlueprintCallable, Category = "UHL|AttachmentPropPool")
+	UMeshComponent* DetachProp(const AActor* Owner, FName UniqueId, EDetachmentRule DetachmentRule = EDetachmentRule::KeepWorld);
+
+	// Hides prop and returns it to pool
+	UFUNCTION(BlueprintCallable, Category = "UHL|AttachmentPropPool")
+	void ReleaseProp(const AActor* Owner, FName UniqueId);
+	// Releases currently attached/detached prop after Delay, cancelled if it's released
+	// (or UniqueId attached again) before that, so newly attached prop is never released by it
+	UFUNCTION(BlueprintCallable, Category = "UHL|AttachmentPropPool")
+	void ReleasePropDelayed(const AActor* Owner, FName UniqueId, float Delay);
+
+	UFUNCTION(BlueprintCallable, Category = "UHL|AttachmentPropPool")
+	void ReleaseAllProps(const AActor* Owner);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FPropKey
+	{
+		TObjectKey<AActor> Owner;
+		FName UniqueId;
+
+		bool operator==(const FPropKey& Other) const { return Owner == Other.Owner && UniqueId == Other.UniqueId; }
+		friend uint32 GetTypeHash(const FPropKey& Key) { return HashCombine(GetTypeHash(Key.Owner), GetTypeHash(Key.UniqueId)); }
+	};
+
+	struct FActiveProp
+	{
+		TWeakObjectPtr<UMeshComponent> Component;
+		TObjectKey<UUHLAttachmentPropData> PropData;
+		FTimerHandle ReleaseTimerHandle;
+	};
+
+	FUHLAttachmentPropPoolSettings Settings;
+
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> PoolActor;
+
+	TMap<FPropKey, FActiveProp> ActiveProps;
+	// released components, reused for same prop without changing mesh
+	TMap<TObjectKey<UUHLAttachmentPropData>, TArray<TWeakObjectPtr<UMeshComponent>>> FreeComponents;
+	int32 NumFreeComponents = 0;
+
+	AActor* GetOrCreatePoolActor();
+	UMeshComponent* AcquireComponent(const UUHLAttachmentPropData* PropData);
+	void SetupComponent(UMeshComponent* MeshComponent, const UUHLAttachmentPropData* PropData) const;
+	void ReleaseComponent(UMeshComponent* MeshComponent, const TObjectKey<UUHLAttachmentPropData>& PropData);
+	// Component check makes sure prop re-attached under same key isn't released by stale request
+	void ReleaseActiveProp(const FPropKey& PropKey, const TWeakObjectPtr<UMeshComponent>* ExpectedComponent);
+	void ClearReleaseTimer(FActiveProp& ActiveProp) const;
+
+	UFUNCTION()
+	void OnOwnerEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+};
@@ -0,0 +1,79 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "UHLCrowdPropMergeCacheSubsystem.generated.h"
+
+class UMaterialInterface;
+class USkeletalMesh;
+class UStaticMesh;
+
+// Static prop as it ends up in merged mesh, transform relative to socket quantized
+struct FUHLMergedStaticPropDesc
+{
+	TObjectKey<UStaticMesh> Mesh;
+	TArray<TObjectKey<UMaterialInterface>, TInlineAllocator<4>> Materials;
+	FIntVector Location = FIntVector::ZeroValue;
+	FIntVector Rotation = FIntVector::ZeroValue;
+	FIntVector Scale = FIntVector::ZeroValue;
+
+	bool operator==(const FUHLMergedStaticPropDesc& Other) const
+	{
+		return Mesh == Other.Mesh && Materials == Other.Materials && Location == Other.Location && Rotation == Other.Rotation && Scale == Other.Scale;
+	}
+	// ordering only has to be stable, used to sort props so same set in different order shares mesh
+	bool operator<(const FUHLMergedStaticPropDesc& Other) const;
+	friend uint32 GetTypeHash(const FUHLMergedStaticPropDesc& Desc);
+};
+
+// Full description of merged static mesh, compared on lookup so hash collisions can't return wrong mesh
+struct FUHLMergedStaticMeshKey
+{
+	int32 LODIndex = 0;
+	TArray<FUHLMergedStaticPropDesc> Props;
+
+	bool operator==(const FUHLMergedStaticMeshKey& Other) const { return LODIndex == Other.LODIndex && Props == Other.Props; }
+	friend uint32 GetTypeHash(const FUHLMergedStaticMeshKey& Key);
+};
+
+// Sorted source meshes of merged skeletal mesh
+struct FUHLMergedSkeletalMeshKey
+{
+	TArray<TObjectKey<USkeletalMesh>> Meshes;
+
+	bool operator==(const FUHLMergedSkeletalMeshKey& Other) const { return Meshes == Other.Meshes; }
+	friend uint32 GetTypeHash(const FUHLMergedSkeletalMeshKey& Key);
+};
+
+/**
+ * Per world cache of meshes merged by UUHLCrowdPropMergeComponent,
+ * enemies with same props share merged mesh. Entries are weak, meshes live while used by components.
+ */
+UCLASS()
+class UNREALHELPERLIBRARY_API UUHLCrowdPropMergeCacheSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	UStaticMesh* FindStaticMesh(const FUHLMergedStaticMeshKey& Key) const;
+	void AddStaticMesh(FUHLMergedStaticMeshKey&& Key, UStaticMesh* Mesh);
+
+	USkeletalMesh* FindSkeletalMesh(const FUHLMergedSkeletalMeshKey& Key) const;
+	void AddSkeletalMesh(FUHLMergedSkeletalMeshKey&& Key, USkeletalMesh* Mesh);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	TMap<FUHLMergedStaticMeshKey, TWeakObjectPtr<UStaticMesh>> StaticMeshes;
+	TMap<FUHLMergedSkeletalMeshKey, TWeakObjectPtr<USkeletalMesh>> SkeletalMeshes;
+
+	// drops entries of destroyed meshes, so cache doesn't grow with every props combination ever merged
+	template <typename MapType>
+	static void RemoveStaleEntries(MapType& Map);
+};
@@ -0,0 +1,144 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CanvasItem.h"
+#include "Engine/Canvas.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UHLDebugGraphSubsystem.generated.h"
+
+class APlayerController;
+class UCanvas;
+
+// Debug graphs are compiled out of shipping builds, pushes become no-op
+#define UHL_DEBUG_GRAPH_ENABLED !UE_BUILD_SHIPPING
+
+#if UHL_DEBUG_GRAPH_ENABLED
+#define UHL_DEBUG_GRAPH_PUSH(WorldContextObject, MetricName, Value) UUHLDebugGraphSubsystem::PushValueToWorld(WorldContextObject, MetricName, Value)
+#else
+#define UHL_DEBUG_GRAPH_PUSH(WorldContextObject, MetricName, Value)
+#endif
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnUHLDebugGraphValuePushed, FName /*MetricName*/, float /*Value*/);
+
+UENUM(BlueprintType)
+enum class EUHLDebugGraphStyle : uint8
+{
+	Bars,
+	Line,
+};
+
+USTRUCT(BlueprintType)
+struct FUHLDebugGraphSettings
+{
+	GENERATED_BODY()
+
+	// Graphs also can be toggled by "UHL.DebugGraph" console variable
+	UPROPERTY(EditAnywhere, Category = "Debug Graph")
+	bool bShowByDefault = false;
+
+	// Pushes "FrameTime" metric in milliseconds every frame
+	UPROPERTY(EditAnywhere, Category = "Debug Graph")
+	bool bRecordFrameTime = true;
+
+	// Samples kept per metric, also max number of bars drawn
+	UPROPERTY(EditAnywhere, Category = "Debug Graph", meta = (ClampMin = "2", ClampMax = "2048"))
+	int32 NumSamples = 200;
+
+	// Top left corner of first graph, in canvas pixels
+	UPROPERTY(EditAnywhere, Category = "Debug Graph")
+	FVector2D Position = FVector2D(50.0f, 50.0f);
+
+	UPROPERTY(EditAnywhere, Category = "Debug Graph")
+	FVector2D GraphSize = FVector2D(300.0f, 60.0f);
+
+	UPROPERTY(EditAnywhere, Category = "Debug Graph", meta = (ClampMin = "0.0"))
+	float GraphSpacing = 20.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Debug Graph")
+	FLinearColor BackgroundColor = FLinearColor(0.0f, 0.0f, 0.0f, 0.5f);
+};
+
+/**
+ * Ring buffer graphs for named metrics (frame time, subsystems cost, traces count, etc.),
+ * drawn on top of game viewport.
+ *
+ * Pushing value is map lookup + write to ring buffer, nothing else happens until graphs shown.
+ * All graphs (backgrounds, bars, lines) are drawn by single canvas triangle batch,
+ * only labels are drawn separately.
+ *
+ * From C++ prefer UHL_DEBUG_GRAPH_PUSH macro, it's compiled out in shipping
+ */
+UCLASS()
+class UNREALHELPERLIBRARY_API UUHLDebugGraphSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	static void PushValueToWorld(const UObject* WorldContextObject, FName MetricName, float Value);
+
+	// Adds sample to metric's graph, metric created on first push
+	UFUNCTION(BlueprintCallable, Category = "UHL|DebugGraph")
+	void PushValue(FName MetricName, float Value);
+
+	/**
+	 * @param MaxValue value at the top of graph, <= 0 - scaled by max sample in buffer
+	 * @param Threshold draws horizontal line, e.g. frame budget, <= 0 - not drawn
+	 */
+	UFUNCTION(BlueprintCallable, Category = "UHL|DebugGraph")
+	void ConfigureMetric(FName MetricName, FLinearColor Color = FLinearColor::Green, EUHLDebugGraphStyle Style = EUHLDebugGraphStyle::Bars,
+		float MaxValue = 0.0f, float Threshold = 0.0f);
+
+	UFUNCTION(BlueprintCallable, Category = "UHL|DebugGraph")
+	void RemoveMetric(FName MetricName);
+
+	UFUNCTION(BlueprintCallable, Category = "UHL|DebugGraph")
+	void SetGraphsVisible(bool bVisible) { bGraphsVisible = bVisible; }
+
+	UFUNCTION(BlueprintPure, Category = "UHL|DebugGraph")
+	bool AreGraphsVisible() const;
+
+	// Every pushed value, e.g. for recording metrics by UUHLPerfCaptureSubsystem
+	FOnUHLDebugGraphValuePushed OnValuePushed;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FMetric
+	{
+		FName Name;
+		TArray<float> Samples;
+		// index where next sample will be written
+		int32 Head = 0;
+		int32 NumValidSamples = 0;
+		float LastValue = 0.0f;
+
+		FLinearColor Color = FLinearColor::Green;
+		EUHLDebugGraphStyle Style = EUHLDebugGraphStyle::Bars;
+		float MaxValue = 0.0f;
+		float Threshold = 0.0f;
+	};
+
+	FUHLDebugGraphSettings Settings;
+	bool bGraphsVisible = false;
+
+	TArray<FMetric> Metrics;
+	TMap<FName, int32> MetricIndexByName;
+
+	FDelegateHandle DrawDelegateHandle;
+	// reused every draw, TriangleList refilled in place, game thread only
+	FCanvasTriangleItem TriangleItem = FCanvasTriangleItem(TArray<FCanvasUVTri>(), nullptr);
+
+	FMetric& FindOrAddMetric(FName MetricName);
+	void Draw(UCanvas* Canvas, APlayerController* PlayerController);
+	void AddQuad(const FVector2D& Min, const FVector2D& Max, const FLinearColor& Color);
+	void AddSegment(const FVector2D& Start, const FVector2D& End, float Thickness, const FLinearColor& Color);
+};
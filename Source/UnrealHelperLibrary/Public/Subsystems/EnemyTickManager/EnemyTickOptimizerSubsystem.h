@@ -4,9 +4,166 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "GameplayTagContainer.h"
+#include "Scalability.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Subsystems/EnemyTickManager/UHLEnemySpatialIndex.h"
+#include "Subsystems/EnemyTickManager/UHLEnemyAnimationSharing.h"
+#include "Subsystems/EnemyTickManager/UHLEnemyTickBatcher.h"
+#include "Subsystems/EnemyTickManager/UHLEnemyCostTracker.h"
 #include "EnemyTickOptimizerSubsystem.generated.h"
 
+class UAnimSequenceBase;
+
+UENUM(BlueprintType)
+enum class EEnemyTickOptimizerTier : uint8
+{
+	// Not evaluated yet
+	None UMETA(Hidden),
+
+	Close,
+	Medium,
+	Far,
+	// Beyond FarDistance, DefaultEnemyTickInterval used
+	OutOfRange,
+	// Beyond MediumDistance and not rendered recently, RecentlyNotRenderedTickInterval used
+	NotRendered,
+};
+
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnEnemyTickOptimizerTierChanged, ACharacter* /*Enemy*/, EEnemyTickOptimizerTier /*OldTier*/, EEnemyTickOptimizerTier /*NewTier*/);
+
+USTRUCT(BlueprintType)
+struct FEnemyTickOptimizerGASSettings
+{
+	GENERATED_BODY()
+
+	// Tick AbilitySystemComponent with its own interval on far tiers,
+	// regular tier interval restored on promotion
+	UPROPERTY(EditAnywhere, Category = "GAS")
+	bool bThrottleAbilitySystem = false;
+
+	// Tiers starting from this one are throttled (tiers order - Close, Medium, Far, OutOfRange, NotRendered)
+	UPROPERTY(EditAnywhere, Category = "GAS", meta = (EditCondition = "bThrottleAbilitySystem"))
+	EEnemyTickOptimizerTier MinThrottledTier = EEnemyTickOptimizerTier::Far;
+
+	UPROPERTY(EditAnywhere, Category = "GAS", meta = (EditCondition = "bThrottleAbilitySystem", ClampMin = "0.0", Units = "Seconds"))
+	float AbilitySystemTickInterval = 1.0f;
+
+	// Requires UUHLGameplayCueManager set as GlobalGameplayCueManagerClass,
+	// cues not matching CriticalGameplayCueTags are skipped on throttled enemies
+	UPROPERTY(EditAnywhere, Category = "GAS", meta = (EditCondition = "bThrottleAbilitySystem"))
+	bool bSuppressNonCriticalGameplayCues = false;
+
+	UPROPERTY(EditAnywhere, Category = "GAS", meta = (EditCondition = "bThrottleAbilitySystem && bSuppressNonCriticalGameplayCues", Categories = "GameplayCue"))
+	FGameplayTagContainer CriticalGameplayCueTags;
+
+	// Works without custom GameplayCueManager but suppresses critical cues too
+	UPROPERTY(EditAnywhere, Category = "GAS", meta = (EditCondition = "bThrottleAbilitySystem"))
+	bool bSuppressAllGameplayCues = false;
+};
+
+USTRUCT(BlueprintType)
+struct FEnemyTickOptimizerSharedAnimState
+{
+	GENERATED_BODY()
+
+	// Used when enemy horizontal speed is at least this, state with highest matching MinSpeed wins
+	UPROPERTY(EditAnywhere, Category = "Animation Sharing", meta = (ClampMin = "0.0", Units = "CentimetersPerSecond"))
+	float MinSpeed = 0.0f;
+
+	// Looped by shared drivers, must use skeleton of enemies meshes
+	UPROPERTY(EditAnywhere, Category = "Animation Sharing")
+	TSoftObjectPtr<UAnimSequenceBase> Animation;
+};
+
+USTRUCT(BlueprintType)
+struct FEnemyTickOptimizerAnimSharingSettings
+{
+	GENERATED_BODY()
+
+	// Enemies in far tiers follow shared animation drivers by leader pose instead of evaluating own anim graph,
+	// own evaluation restored on promotion
+	UPROPERTY(EditAnywhere, Category = "Animation Sharing")
+	bool bEnableAnimationSharing = false;
+
+	// Tiers starting from this one are shared (tiers order - Close, Medium, Far, OutOfRange, NotRendered)
+	UPROPERTY(EditAnywhere, Category = "Animation Sharing", meta = (EditCondition = "bEnableAnimationSharing"))
+	EEnemyTickOptimizerTier MinSharedTier = EEnemyTickOptimizerTier::Far;
+
+	// e.g. idle, walk, run
+	UPROPERTY(EditAnywhere, Category = "Animation Sharing", meta = (EditCondition = "bEnableAnimationSharing"))
+	TArray<FEnemyTickOptimizerSharedAnimState> States;
+
+	// Drivers with different start time per mesh and state, so crowd doesn't move in sync
+	UPROPERTY(EditAnywhere, Category = "Animation Sharing", meta = (EditCondition = "bEnableAnimationSharing", ClampMin = "1", ClampMax = "8"))
+	int32 DriversPerState = 3;
+};
+
+USTRUCT(BlueprintType)
+struct FEnemyTickOptimizerCostSettings
+{
+	GENERATED_BODY()
+
+	// Time sampled ticks of batched enemies (requires bBatchTicks), batched skeletal meshes timed as anim cost
+	UPROPERTY(EditAnywhere, Category = "Cost Attribution")
+	bool bMeasureTickCost = false;
+
+	// Every N-th batched tick of enemy is timed
+	UPROPERTY(EditAnywhere, Category = "Cost Attribution", meta = (EditCondition = "bMeasureTickCost", ClampMin = "1"))
+	int32 SampleRate = 8;
+
+	// Weight of new sample in moving average, lower - smoother but slower to react
+	UPROPERTY(EditAnywhere, Category = "Cost Attribution", meta = (EditCondition = "bMeasureTickCost", ClampMin = "0.01", ClampMax = "1.0"))
+	float Smoothing = 0.1f;
+
+	// Class cost used only after this many samples
+	UPROPERTY(EditAnywhere, Category = "Cost Attribution", meta = (EditCondition = "bMeasureTickCost", ClampMin = "1"))
+	int32 MinSamples = 16;
+
+	// Also keep cost of every enemy, not only of its class
+	UPROPERTY(EditAnywhere, Category = "Cost Attribution", meta = (EditCondition = "bMeasureTickCost"))
+	bool bTrackInstances = false;
+
+	// Distance used for tier is multiplied by (class cost / average cost) ^ CostInfluence,
+	// so expensive enemies drop to reduced tiers closer to player and cheap ones later.
+	// Ignored if bBatchTicks disabled. Costs are sampled only in batched tiers, so weighting feeds back
+	// into what gets sampled - class that stays closer than MinBatchedTier is never measured and keeps cost 1
+	UPROPERTY(EditAnywhere, Category = "Cost Attribution", meta = (EditCondition = "bMeasureTickCost"))
+	bool bWeightTiersByCost = false;
+
+	UPROPERTY(EditAnywhere, Category = "Cost Attribution", meta = (EditCondition = "bMeasureTickCost && bWeightTiersByCost", ClampMin = "0.0", ClampMax = "1.0"))
+	float CostInfluence = 0.5f;
+
+	UPROPERTY(EditAnywhere, Category = "Cost Attribution", meta = (EditCondition = "bMeasureTickCost && bWeightTiersByCost", ClampMin = "0.1"))
+	float MinDistanceScale = 0.5f;
+
+	UPROPERTY(EditAnywhere, Category = "Cost Attribution", meta = (EditCondition = "bMeasureTickCost && bWeightTiersByCost", ClampMin = "1.0"))
+	float MaxDistanceScale = 2.0f;
+};
+
+USTRUCT(BlueprintType)
+struct FEnemyTickOptimizerClassCost
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "EnemyTickOptimizer")
+	TObjectPtr<UClass> EnemyClass = nullptr;
+
+	// Average cost of single tick without skeletal meshes
+	UPROPERTY(BlueprintReadOnly, Category = "EnemyTickOptimizer")
+	float TickMs = 0.0f;
+
+	// Average cost of skeletal meshes tick, 0 if they aren't batched
+	UPROPERTY(BlueprintReadOnly, Category = "EnemyTickOptimizer")
+	float AnimMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "EnemyTickOptimizer")
+	int32 Samples = 0;
+
+	// Cost relative to average sampled enemy, 1 until MinSamples collected
+	UPROPERTY(BlueprintReadOnly, Category = "EnemyTickOptimizer")
+	float RelativeCost = 1.0f;
+};
 
 USTRUCT(BlueprintType)
 struct FEnemyTickOptimizerSubsystemSettings
@@ -49,6 +206,81 @@ struct FEnemyTickOptimizerSubsystemSettings
 	
 	UPROPERTY(EditAnywhere, Category = "Tick Optimization")
 	float RecentlyNotRenderedTickInterval = 1.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Tick Optimization")
+	FEnemyTickOptimizerGASSettings GASSettings;
+
+	UPROPERTY(EditAnywhere, Category = "Tick Optimization")
+	FEnemyTickOptimizerAnimSharingSettings AnimSharingSettings;
+
+	// Enemies in reduced tiers ticked by single tick function per tier instead of
+	// own actor/components/controller tick functions, same intervals
+	UPROPERTY(EditAnywhere, Category = "Tick Batching")
+	bool bBatchTicks = false;
+
+	// Tiers starting from this one are batched (tiers order - Close, Medium, Far, OutOfRange, NotRendered)
+	UPROPERTY(EditAnywhere, Category = "Tick Batching", meta = (EditCondition = "bBatchTicks"))
+	EEnemyTickOptimizerTier MinBatchedTier = EEnemyTickOptimizerTier::Medium;
+
+	// Batched skeletal meshes evaluate animation on game thread, otherwise they keep native tick
+	UPROPERTY(EditAnywhere, Category = "Tick Batching", meta = (EditCondition = "bBatchTicks"))
+	bool bBatchSkeletalMeshes = false;
+
+	UPROPERTY(EditAnywhere, Category = "Cost Attribution")
+	FEnemyTickOptimizerCostSettings CostSettings;
+
+	// Keep grid of registered enemies for radius/k-nearest/cone/box queries,
+	// works even if tick optimization itself disabled
+	UPROPERTY(EditAnywhere, Category = "Spatial Index")
+	bool bEnableSpatialIndex = true;
+
+	// Better to keep it close to most common query radius
+	UPROPERTY(EditAnywhere, Category = "Spatial Index", meta = (EditCondition = "bEnableSpatialIndex", ClampMin = "100.0", Units = "Centimeters"))
+	float SpatialIndexCellSize = 1000.0f;
+
+	// Enemies locations re-read on first query after this time passed, 0 - once per frame at most
+	UPROPERTY(EditAnywhere, Category = "Spatial Index", meta = (EditCondition = "bEnableSpatialIndex", ClampMin = "0.0", Units = "Seconds"))
+	float SpatialIndexMaxAge = 0.0f;
+};
+
+UENUM(BlueprintType)
+enum class EEnemyTickOptimizerScalabilityGroup : uint8
+{
+	// Lowest level among all "sg." groups
+	Overall,
+	ViewDistance,
+	Shadow,
+	Effects,
+	Foliage,
+	Shading,
+};
+
+// Replaces EnemyTickOptimizerSubsystemSettings when all conditions match
+USTRUCT(BlueprintType)
+struct FEnemyTickOptimizerSettingsOverride
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Conditions")
+	EEnemyTickOptimizerScalabilityGroup ScalabilityGroup = EEnemyTickOptimizerScalabilityGroup::Overall;
+
+	// Used when level of ScalabilityGroup is at most this (0 - Low, 1 - Medium, 2 - High, 3 - Epic, 4 - Cinematic)
+	UPROPERTY(EditAnywhere, Category = "Conditions", meta = (ClampMin = "0", ClampMax = "4"))
+	int32 MaxScalabilityLevel = 4;
+
+	// Names from UGameplayStatics::GetPlatformName e.g. "Windows", "Android", empty - any platform
+	UPROPERTY(EditAnywhere, Category = "Conditions")
+	TArray<FString> Platforms;
+
+	// Empty - any device profile
+	UPROPERTY(EditAnywhere, Category = "Conditions")
+	TArray<FString> DeviceProfiles;
+
+	UPROPERTY(EditAnywhere, Category = "Conditions")
+	bool bDedicatedServerOnly = false;
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FEnemyTickOptimizerSubsystemSettings Settings;
 };
 
 /**
@@ -69,7 +301,56 @@ public:
 	// Unregister an enemy from the subsystem
 	void UnregisterEnemy(ACharacter* Enemy);
 
+	/** Spatial index queries, OutEnemies is Reset() - reuse same array to avoid allocations **/
+	UFUNCTION(BlueprintCallable, Category = "EnemyTickOptimizer|SpatialIndex")
+	void QueryEnemiesInRadius(FVector Center, float Radius, TArray<ACharacter*>& OutEnemies);
+	// Sorted from nearest to farthest, MaxRadius <= 0 means unlimited
+	UFUNCTION(BlueprintCallable, Category = "EnemyTickOptimizer|SpatialIndex")
+	void QueryNearestEnemies(FVector Center, int32 Count, float MaxRadius, TArray<ACharacter*>& OutEnemies);
+	UFUNCTION(BlueprintCallable, Category = "EnemyTickOptimizer|SpatialIndex")
+	void QueryEnemiesInCone(FVector Origin, FVector Direction, float HalfAngleDegrees, float Range, TArray<ACharacter*>& OutEnemies);
+	UFUNCTION(BlueprintCallable, Category = "EnemyTickOptimizer|SpatialIndex")
+	void QueryEnemiesInBox(FBox Box, TArray<ACharacter*>& OutEnemies);
+
+	// For C++ users that want to query index directly, refreshed if stale
+	const FUHLEnemySpatialIndex& GetSpatialIndex();
+	/** ~Spatial index queries **/
+
+	// Tier enemy was put in on last update, None if not evaluated yet
+	UFUNCTION(BlueprintPure, Category = "EnemyTickOptimizer")
+	EEnemyTickOptimizerTier GetEnemyTier(const ACharacter* Enemy) const;
+
+	// Per-enemy, so components of enemy don't get notified about tier changes of others
+	FDelegateHandle AddOnTierChangedHandler(const ACharacter* Enemy, FOnEnemyTickOptimizerTierChanged::FDelegate&& Delegate);
+	void RemoveOnTierChangedHandler(const ACharacter* Enemy, FDelegateHandle Handle);
+
+	bool IsAbilitySystemThrottled(const AActor* Actor) const;
+	bool IsAnimationShared(const ACharacter* Enemy) const { return AnimationSharing.IsShared(Enemy); }
+
+	/** Cost attribution, filled only if CostSettings.bMeasureTickCost **/
+	// Sorted from most expensive
+	UFUNCTION(BlueprintCallable, Category = "EnemyTickOptimizer|Cost")
+	void GetEnemyClassCosts(TArray<FEnemyTickOptimizerClassCost>& OutCosts) const;
+	// Instance cost if bTrackInstances, otherwise cost of enemy class, -1 if not sampled yet
+	UFUNCTION(BlueprintPure, Category = "EnemyTickOptimizer|Cost")
+	float GetEnemyTickCostMs(const ACharacter* Enemy) const;
+	const FUHLEnemyCostTracker& GetCostTracker() const { return CostTracker; }
+	/** ~Cost attribution **/
+	// Used by UUHLGameplayCueManager
+	bool ShouldSuppressGameplayCue(const AActor* TargetActor, const FGameplayTag& GameplayCueTag) const;
+
 private:
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FUHLEnemyTickOptimizerAllocationTest;
+#endif
+
+	struct FEnemyTickOptimizerEnemyState
+	{
+		EEnemyTickOptimizerTier Tier = EEnemyTickOptimizerTier::None;
+		bool bAbilitySystemThrottled = false;
+		bool bInitialSuppressGameplayCues = false;
+	};
+
 	// Array to store all registered enemies
 	TArray<ACharacter*> RegisteredEnemies;
 
@@ -79,8 +360,37 @@ private:
 	// Function to update tick intervals based on distance to the player
 	void UpdateTickIntervals();
 
+	EEnemyTickOptimizerTier CalculateTier(const ACharacter* Enemy, float Distance) const;
+	// Multiplier of distance used for tier, from measured class cost
+	float GetCostDistanceScale(const ACharacter* Enemy) const;
+	void PushCostsToDebugGraph() const;
+	float GetTierTickInterval(EEnemyTickOptimizerTier Tier) const;
+	void OnEnemyTierChanged(ACharacter* Enemy, FEnemyTickOptimizerEnemyState& EnemyState, EEnemyTickOptimizerTier NewTier);
+	// Reverts everything optimizer changed on enemy except tick intervals
+	void RestoreEnemyState(ACharacter* Enemy);
+
 	// Configurable properties for distance thresholds and tick intervals
 	FEnemyTickOptimizerSubsystemSettings Settings;
+	FDelegateHandle ScalabilityChangedHandle;
+
+	// Enemies states reverted with previous settings, tiers re-evaluated on next update
+	void ApplySettings(const FEnemyTickOptimizerSubsystemSettings& NewSettings);
+	void OnScalabilitySettingsChanged(const Scalability::FQualityLevels& QualityLevels);
+
+	TMap<TObjectKey<ACharacter>, FEnemyTickOptimizerEnemyState> EnemyStates;
+	TMap<TObjectKey<ACharacter>, FOnEnemyTickOptimizerTierChanged> TierChangedDelegates;
+
+	FUHLEnemySpatialIndex SpatialIndex;
+	FUHLEnemyAnimationSharing AnimationSharing;
+	// Keeps animations loaded by AnimationSharing alive
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UAnimSequenceBase>> SharedAnimations;
+	FUHLEnemyTickBatcher TickBatcher;
+	FUHLEnemyCostTracker CostTracker;
+	uint64 SpatialIndexRefreshFrame = 0;
+	double SpatialIndexRefreshTime = -1.0;
+
+	void RefreshSpatialIndexIfStale();
 	
 	bool bTickAllowed = false;
 	float AccumulatedTime = 0.0f;
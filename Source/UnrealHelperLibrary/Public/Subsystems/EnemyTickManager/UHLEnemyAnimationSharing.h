@@ -0,0 +1,76 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class ACharacter;
+class UAnimSequenceBase;
+class USkeletalMesh;
+class USkeletalMeshComponent;
+struct FEnemyTickOptimizerAnimSharingSettings;
+
+/**
+ * Leader pose sharing for far crowds, used by UEnemyTickOptimizerSubsystem.
+ *
+ * For every skeletal mesh asset and animation state (idle/walk/run picked by speed)
+ * few hidden driver meshes play looped animation with different start offsets.
+ * Shared enemy mesh follows one of drivers and its own anim instance is paused,
+ * so anim-thread cost of crowd is number of drivers, not number of enemies.
+ *
+ * Enemies playing montages aren't shared. Mesh followers of enemy mesh
+ * (modular characters) follow driver too while shared.
+ */
+struct UNREALHELPERLIBRARY_API FUHLEnemyAnimationSharing
+{
+public:
+	void SetSettings(const FEnemyTickOptimizerAnimSharingSettings& InSettings);
+	// Helper isn't visible to GC, owner has to keep loaded animations referenced
+	void GetAnimations(TArray<TObjectPtr<UAnimSequenceBase>>& OutAnimations) const;
+	// Destroys drivers and restores all shared enemies
+	void Reset();
+
+	bool IsShared(const ACharacter* Enemy) const { return SharedEnemies.Contains(TObjectKey<ACharacter>(Enemy)); }
+	int32 NumDrivers() const;
+
+	// Returns false if enemy can't be shared right now
+	bool ShareEnemy(ACharacter* Enemy);
+	void UnshareEnemy(ACharacter* Enemy);
+	// Switches driver if enemy speed now matches other state, unshares enemy started montage
+	void UpdateEnemy(ACharacter* Enemy);
+
+private:
+	struct FSharedEnemy
+	{
+		TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+		TArray<TWeakObjectPtr<USkeletalMeshComponent>> Followers;
+		int32 StateIndex = INDEX_NONE;
+		bool bInitialPauseAnims = false;
+	};
+
+	struct FDriverKey
+	{
+		TObjectKey<USkeletalMesh> Mesh;
+		int32 StateIndex = INDEX_NONE;
+
+		bool operator==(const FDriverKey& Other) const { return Mesh == Other.Mesh && StateIndex == Other.StateIndex; }
+		friend uint32 GetTypeHash(const FDriverKey& Key) { return HashCombine(GetTypeHash(Key.Mesh), ::GetTypeHash(Key.StateIndex)); }
+	};
+
+	struct FState
+	{
+		float MinSpeed = 0.0f;
+		TWeakObjectPtr<UAnimSequenceBase> Animation;
+	};
+
+	TArray<FState> States;
+	int32 DriversPerState = 1;
+
+	TMap<TObjectKey<ACharacter>, FSharedEnemy> SharedEnemies;
+	TMap<FDriverKey, TArray<TWeakObjectPtr<USkeletalMeshComponent>>> Drivers;
+
+	int32 GetStateIndex(const ACharacter* Enemy) const;
+	USkeletalMeshComponent* GetOrCreateDriver(const ACharacter* Enemy, USkeletalMesh* SkeletalMesh, int32 StateIndex);
+	void SetLeader(FSharedEnemy& SharedEnemy, USkeletalMeshComponent* Leader) const;
+};
@@ -0,0 +1,58 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class ACharacter;
+struct FEnemyTickOptimizerCostSettings;
+
+// Smoothed cost of single tick, milliseconds
+struct FUHLEnemyCost
+{
+	double TickMs = 0.0;
+	// skeletal meshes part of tick
+	double AnimMs = 0.0;
+	int32 Samples = 0;
+	// "EnemyTickCostMs.<Class>", built once when class first sampled
+	FName DebugGraphMetricName;
+
+	double GetTotalMs() const { return TickMs + AnimMs; }
+	void AddSample(double SampleTickMs, double SampleAnimMs, float Smoothing);
+};
+
+/**
+ * Sampled tick cost per enemy class (and optionally per instance), used by UEnemyTickOptimizerSubsystem.
+ *
+ * Fed by FUHLEnemyTickBatcher, which times every "SampleRate"-th batched tick of enemy,
+ * skeletal meshes timed separately as anim cost. Samples are averaged by exponential moving average,
+ * so costs follow changes of enemy behaviour over time.
+ */
+struct UNREALHELPERLIBRARY_API FUHLEnemyCostTracker
+{
+public:
+	void SetSettings(const FEnemyTickOptimizerCostSettings& InSettings);
+	void Reset();
+
+	bool ShouldSample(uint32 TickCount) const { return SampleRate > 0 && TickCount % SampleRate == 0; }
+	void AddSample(const ACharacter* Enemy, double TickMs, double AnimMs);
+	void RemoveInstance(const ACharacter* Enemy) { CostByInstance.Remove(Enemy); }
+
+	// Class cost divided by cost of average sampled enemy, 1 if class isn't sampled enough yet
+	float GetRelativeCost(const UClass* EnemyClass) const;
+	// Instance cost if tracked, otherwise cost of its class
+	const FUHLEnemyCost* FindCost(const ACharacter* Enemy) const;
+	const FUHLEnemyCost& GetAverageCost() const { return AverageCost; }
+	const TMap<TObjectKey<UClass>, FUHLEnemyCost>& GetClassCosts() const { return CostByClass; }
+
+private:
+	int32 SampleRate = 0;
+	float Smoothing = 0.1f;
+	int32 MinSamples = 1;
+	bool bTrackInstances = false;
+
+	FUHLEnemyCost AverageCost;
+	TMap<TObjectKey<UClass>, FUHLEnemyCost> CostByClass;
+	TMap<TObjectKey<ACharacter>, FUHLEnemyCost> CostByInstance;
+};
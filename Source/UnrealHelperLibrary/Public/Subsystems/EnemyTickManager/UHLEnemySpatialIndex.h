@@ -0,0 +1,68 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class ACharacter;
+
+/**
+ * Uniform 2D grid over enemies registered in UEnemyTickOptimizerSubsystem.
+ *
+ * Entries are updated in place, cell lists only change when enemy crosses cell border,
+ * so keeping index up to date every frame is cheap.
+ * Queries write into caller-provided array (Reset, not Empty) - reuse same array
+ * between calls and steady-state queries won't allocate.
+ * Z is not used for bucketing, but respected by radius/cone/box filters.
+ */
+struct UNREALHELPERLIBRARY_API FUHLEnemySpatialIndex
+{
+public:
+	void SetCellSize(float InCellSize);
+	float GetCellSize() const { return CellSize; }
+
+	void Add(ACharacter* Enemy);
+	void Remove(const ACharacter* Enemy);
+	// Update single enemy location, cheap if enemy stays in same cell
+	void Update(const ACharacter* Enemy, const FVector& Location);
+	// Re-read locations of all enemies, removes destroyed ones
+	void UpdateAll();
+	void Reset();
+
+	int32 Num() const { return Entries.Num(); }
+	bool Contains(const ACharacter* Enemy) const { return EntryIndexByEnemy.Contains(TObjectKey<ACharacter>(Enemy)); }
+
+	void QueryRadius(const FVector& Center, float Radius, TArray<ACharacter*>& OutEnemies) const;
+	// Sorted from nearest to farthest, MaxRadius <= 0 means unlimited
+	void QueryKNearest(const FVector& Center, int32 K, float MaxRadius, TArray<ACharacter*>& OutEnemies) const;
+	void QueryCone(const FVector& Origin, const FVector& Direction, float HalfAngleDegrees, float Range, TArray<ACharacter*>& OutEnemies) const;
+	void QueryBox(const FBox& Box, TArray<ACharacter*>& OutEnemies) const;
+
+private:
+	struct FEntry
+	{
+		TObjectKey<ACharacter> Key;
+		TWeakObjectPtr<ACharacter> Enemy;
+		FVector Location = FVector::ZeroVector;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+	};
+
+	float CellSize = 1000.0f;
+
+	TArray<FEntry> Entries;
+	TMap<TObjectKey<ACharacter>, int32> EntryIndexByEnemy;
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	// reused by QueryKNearest, game thread only
+	mutable TArray<TPair<double, int32>> ScratchHeap;
+
+	FIntPoint GetCell(const FVector& Location) const;
+	void AddToCell(const FIntPoint& Cell, int32 EntryIndex);
+	void RemoveFromCell(const FIntPoint& Cell, int32 EntryIndex);
+	void RemoveAt(int32 EntryIndex);
+
+	// Calls Visitor(const FEntry&) for every entry in cells overlapping [Min, Max]
+	template <typename VisitorType>
+	void ForEachEntryInCells(const FVector2D& Min, const FVector2D& Max, VisitorType&& Visitor) const;
+};
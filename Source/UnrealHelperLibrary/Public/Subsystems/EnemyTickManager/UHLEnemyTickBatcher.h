@@ -0,0 +1,98 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "UObject/ObjectKey.h"
+
+class ACharacter;
+class AController;
+class UActorComponent;
+class UWorld;
+struct FUHLEnemyCostTracker;
+struct FUHLEnemyTickBatcher;
+
+// Single tick function for all batched enemies of one tier
+struct FUHLEnemyTierTickFunction : public FTickFunction
+{
+	FUHLEnemyTickBatcher* Batcher = nullptr;
+	int32 BatchIndex = INDEX_NONE;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+/**
+ * Batched ticking of enemies in reduced tiers, used by UEnemyTickOptimizerSubsystem.
+ *
+ * Native tick functions of batched enemy, its components and controller are disabled,
+ * one tick function per batch walks contiguous array of enemies and ticks those that are due,
+ * keeping interval and phase. Saves tick task manager scheduling for thousands of entries.
+ *
+ * Ticks run on game thread in TG_PrePhysics in order controller -> actor -> components,
+ * tick prerequisites between them aren't respected.
+ * Skeletal meshes are kept on native tick unless "bBatchSkeletalMeshes",
+ * batched ones evaluate animation on game thread.
+ * If "CostTracker" set, every CostTracker->SampleRate-th tick of enemy is timed and reported to it.
+ *
+ * Only ticks enabled when enemy was added are batched and enabled back on removal.
+ * If gameplay re-enables native tick of batched actor/controller/component (SetActorTickEnabled,
+ * SetComponentTickEnabled, Activate) or deactivates component, it's released from batch on its next batched tick
+ * and left in that state. Disabling tick without deactivation can't be detected while batched.
+ */
+struct UNREALHELPERLIBRARY_API FUHLEnemyTickBatcher
+{
+public:
+	FUHLEnemyTickBatcher() = default;
+	FUHLEnemyTickBatcher(const FUHLEnemyTickBatcher&) = delete;
+	FUHLEnemyTickBatcher& operator=(const FUHLEnemyTickBatcher&) = delete;
+	~FUHLEnemyTickBatcher();
+
+	bool bBatchSkeletalMeshes = false;
+	FUHLEnemyCostTracker* CostTracker = nullptr;
+
+	// Moves enemy to batch or changes its batch/interval
+	void AddEnemy(ACharacter* Enemy, int32 BatchIndex, float TickInterval);
+	// Native ticks restored
+	void RemoveEnemy(const ACharacter* Enemy);
+	void Reset();
+
+	bool Contains(const ACharacter* Enemy) const { return LocationByEnemy.Contains(TObjectKey<ACharacter>(Enemy)); }
+	int32 Num() const { return LocationByEnemy.Num(); }
+
+	void TickBatch(int32 BatchIndex, float DeltaTime, ELevelTick TickType);
+
+private:
+	struct FBatchedEnemy
+	{
+		TObjectKey<ACharacter> Key;
+		TWeakObjectPtr<ACharacter> Enemy;
+		// ticks owned by batch, natively disabled while batched
+		TWeakObjectPtr<AController> Controller;
+		TArray<TWeakObjectPtr<UActorComponent>, TInlineAllocator<8>> Components;
+		bool bActorTick = false;
+		float TickInterval = 0.0f;
+		double NextTickTime = 0.0;
+		double LastTickTime = 0.0;
+		uint32 TickCount = 0;
+	};
+
+	struct FBatch
+	{
+		FUHLEnemyTierTickFunction TickFunction;
+		TArray<FBatchedEnemy> Enemies;
+	};
+
+	// tick functions must not move, batches allocated separately
+	TArray<TUniquePtr<FBatch>> Batches;
+	// batch index and index in batch
+	TMap<TObjectKey<ACharacter>, FIntPoint> LocationByEnemy;
+	TWeakObjectPtr<UWorld> World;
+
+	FBatch& GetOrCreateBatch(int32 BatchIndex, UWorld* InWorld);
+	// Caller removes taken enemy from LocationByEnemy
+	FBatchedEnemy TakeFromBatch(const FIntPoint& Location);
+	static void RestoreNativeTicks(const FBatchedEnemy& BatchedEnemy);
+};
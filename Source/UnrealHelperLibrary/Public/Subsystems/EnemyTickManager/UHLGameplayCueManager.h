@@ -0,0 +1,24 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayCueManager.h"
+#include "UHLGameplayCueManager.generated.h"
+
+/**
+ * Skips non-critical GameplayCues on enemies throttled by UEnemyTickOptimizerSubsystem,
+ * see FEnemyTickOptimizerGASSettings::CriticalGameplayCueTags.
+ *
+ * To use - set in DefaultGame.ini
+ * [/Script/GameplayAbilities.AbilitySystemGlobals]
+ * GlobalGameplayCueManagerClass=/Script/UnrealHelperLibrary.UHLGameplayCueManager
+ */
+UCLASS()
+class UNREALHELPERLIBRARY_API UUHLGameplayCueManager : public UGameplayCueManager
+{
+	GENERATED_BODY()
+
+public:
+	virtual void HandleGameplayCue(AActor* TargetActor, FGameplayTag GameplayCueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters, EGameplayCueExecutionOptions Options = EGameplayCueExecutionOptions::Default) override;
+};
@@ -0,0 +1,128 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UHLGroundHeightSubsystem.generated.h"
+
+USTRUCT(BlueprintType)
+struct FUHLGroundHeightSubsystemSettings
+{
+	GENERATED_BODY()
+
+	// If disabled every query traces, same as without cache
+	UPROPERTY(EditAnywhere, Category = "Ground Height")
+	bool bEnable = false;
+
+	// Ground sampled once per cell (at cell center), keep it small enough for your terrain
+	UPROPERTY(EditAnywhere, Category = "Ground Height", meta = (EditCondition = "bEnable", ClampMin = "10.0", Units = "Centimeters"))
+	float CellSize = 50.0f;
+
+	// Queries inside same XY cell but different Z band are cached separately (bridges, floors)
+	UPROPERTY(EditAnywhere, Category = "Ground Height", meta = (EditCondition = "bEnable", ClampMin = "50.0", Units = "Centimeters"))
+	float HeightBandSize = 400.0f;
+
+	// How deep we trace from query band
+	UPROPERTY(EditAnywhere, Category = "Ground Height", meta = (EditCondition = "bEnable", ClampMin = "0.0", Units = "Centimeters"))
+	float MaxTraceDistance = 10000.0f;
+
+	// Traced by object types, so pawns and their meshes never get cached as ground
+	UPROPERTY(EditAnywhere, Category = "Ground Height", meta = (EditCondition = "bEnable"))
+	TArray<TEnumAsByte<ECollisionChannel>> GroundObjectTypes = { ECC_WorldStatic, ECC_WorldDynamic };
+
+	// Ground checks of UHL notifies/BPL tracing these channels may be answered from cache,
+	// checks with other channels keep tracing their own channel
+	UPROPERTY(EditAnywhere, Category = "Ground Height", meta = (EditCondition = "bEnable"))
+	TArray<TEnumAsByte<ECollisionChannel>> CacheableTraceChannels = { ECC_Visibility };
+
+	// 0 - cells live until invalidated
+	UPROPERTY(EditAnywhere, Category = "Ground Height", meta = (EditCondition = "bEnable", ClampMin = "0.0", Units = "Seconds"))
+	float CellLifetime = 0.0f;
+
+	// Expired cells pruned when exceeded, whole cache dropped if it doesn't help
+	UPROPERTY(EditAnywhere, Category = "Ground Height", meta = (EditCondition = "bEnable", ClampMin = "1"))
+	int32 MaxCells = 65536;
+
+	// Invalidate cells under bounds of spawned/destroyed non-pawn actors with collision
+	UPROPERTY(EditAnywhere, Category = "Ground Height", meta = (EditCondition = "bEnable"))
+	bool bInvalidateOnActorSpawnAndDestroy = true;
+};
+
+USTRUCT(BlueprintType)
+struct FUHLGroundSample
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Ground Height")
+	bool bHasGround = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Ground Height")
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Ground Height")
+	FVector Normal = FVector::UpVector;
+};
+
+/**
+ * Caches downward traces in sparse grid, cell keyed by XY cell and Z band.
+ * Cells are filled on first query and read from memory afterwards,
+ * call Invalidate* when geometry changes (moving platforms, destruction).
+ *
+ * Cell traced from top of its band, cached hit above query point (overhang, ceiling)
+ * or on IgnoredActor/its attachments isn't used - query traced down from its own location then.
+ * Hits on attached actors (props carried by someone) are never cached.
+ */
+UCLASS()
+class UNREALHELPERLIBRARY_API UUHLGroundHeightSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Ground under Location, Location.XY snapped to cell center when cached.
+	// IgnoredActor and actors attached to it are never returned as ground (usually querying character)
+	UFUNCTION(BlueprintCallable, Category = "UHL|GroundHeight")
+	FUHLGroundSample GetGround(const FVector& Location, const AActor* IgnoredActor = nullptr);
+	// Returns false if there is no ground in MaxTraceDistance
+	bool GetGroundHeight(const FVector& Location, float& OutHeight, FVector* OutNormal = nullptr, const AActor* IgnoredActor = nullptr);
+
+	UFUNCTION(BlueprintCallable, Category = "UHL|GroundHeight")
+	void InvalidateBox(const FBox& Box);
+	UFUNCTION(BlueprintCallable, Category = "UHL|GroundHeight")
+	void InvalidateActor(const AActor* Actor);
+	UFUNCTION(BlueprintCallable, Category = "UHL|GroundHeight")
+	void InvalidateAll();
+
+	bool IsCacheEnabled() const { return Settings.bEnable; }
+	// Ground check by TraceChannel can use GetGround instead of own trace
+	bool CanAnswerTrace(ECollisionChannel TraceChannel) const { return Settings.bEnable && Settings.CacheableTraceChannels.Contains(TraceChannel); }
+	int32 GetNumCachedCells() const { return Cells.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FCachedCell
+	{
+		FUHLGroundSample Sample;
+		TWeakObjectPtr<const AActor> HitActor;
+		double TimeCached = 0.0;
+	};
+
+	FUHLGroundHeightSubsystemSettings Settings;
+	FCollisionObjectQueryParams ObjectQueryParams;
+	TMap<FIntVector, FCachedCell> Cells;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+
+	FIntVector GetCellKey(const FVector& Location) const;
+	FUHLGroundSample TraceGround(const FVector& Start, const AActor* IgnoredActor, const AActor** OutHitActor = nullptr) const;
+	static bool IsCachedSampleUsable(const FCachedCell& CachedCell, const FVector& Location, const AActor* IgnoredActor);
+	void PruneCells();
+	void OnActorSpawnedOrDestroyed(AActor* Actor);
+};
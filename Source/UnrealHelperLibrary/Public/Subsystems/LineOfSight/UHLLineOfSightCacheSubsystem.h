@@ -0,0 +1,118 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "WorldCollision.h"
+#include "UHLLineOfSightCacheSubsystem.generated.h"
+
+USTRUCT(BlueprintType)
+struct FUHLLineOfSightCacheSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Line Of Sight Cache")
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Visibility;
+
+	// Max async traces started per frame
+	UPROPERTY(EditAnywhere, Category = "Line Of Sight Cache", meta = (ClampMin = "1"))
+	int32 MaxTracesPerFrame = 16;
+
+	// Pair won't be re-traced until its result is older than this
+	UPROPERTY(EditAnywhere, Category = "Line Of Sight Cache", meta = (ClampMin = "0.0", Units = "Seconds"))
+	float MinRefreshInterval = 0.1f;
+
+	// Pair removed if nobody queried it for this time
+	UPROPERTY(EditAnywhere, Category = "Line Of Sight Cache", meta = (ClampMin = "0.0", Units = "Seconds"))
+	float PairExpireTime = 2.0f;
+
+	// Trace synchronously on first query of pair, otherwise first query returns "unknown"
+	UPROPERTY(EditAnywhere, Category = "Line Of Sight Cache")
+	bool bTraceImmediatelyIfUnknown = false;
+};
+
+/**
+ * Caches line of sight between observer/target pairs.
+ * Every query registers pair, each frame budgeted amount of
+ * stalest/most important pairs refreshed by async traces.
+ * Results arrive next frame, query returns last known result and its age.
+ *
+ * Trace goes from observer eyes viewpoint to target location,
+ * target visible if nothing blocks trace or first blocking hit is target itself.
+ */
+UCLASS()
+class UNREALHELPERLIBRARY_API UUHLLineOfSightCacheSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Returns false if pair has no result yet.
+	 * Priority scales how fast pair gets stale compared to others,
+	 * highest priority passed since last refresh is used
+	 */
+	UFUNCTION(BlueprintCallable, Category = "UHL|LineOfSightCache")
+	bool GetLineOfSight(AActor* Observer, AActor* Target, bool& bOutHasLineOfSight, float& OutAge, float Priority = 1.0f);
+
+	// Next refresh of pair will be scheduled before others
+	UFUNCTION(BlueprintCallable, Category = "UHL|LineOfSightCache")
+	void RequestRefresh(AActor* Observer, AActor* Target);
+
+	UFUNCTION(BlueprintCallable, Category = "UHL|LineOfSightCache")
+	void RemoveActor(AActor* Actor);
+
+	int32 GetNumPairs() const { return Pairs.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FPairKey
+	{
+		TObjectKey<AActor> Observer;
+		TObjectKey<AActor> Target;
+
+		bool operator==(const FPairKey& Other) const { return Observer == Other.Observer && Target == Other.Target; }
+		friend uint32 GetTypeHash(const FPairKey& Key) { return HashCombine(GetTypeHash(Key.Observer), GetTypeHash(Key.Target)); }
+	};
+
+	struct FPairState
+	{
+		TWeakObjectPtr<AActor> Observer;
+		TWeakObjectPtr<AActor> Target;
+
+		uint32 Id = 0;
+		float Priority = 1.0f;
+		bool bHasResult = false;
+		bool bHasLineOfSight = false;
+		bool bTracePending = false;
+		bool bRefreshRequested = false;
+		double ResultTime = 0.0;
+		double LastQueryTime = 0.0;
+	};
+
+	FUHLLineOfSightCacheSettings Settings;
+
+	TMap<FPairKey, FPairState> Pairs;
+	// async trace UserData -> pair
+	TMap<uint32, FPairKey> PendingTraces;
+	uint32 NextPairId = 1;
+
+	FTraceDelegate TraceDelegate;
+	// reused by Tick
+	TArray<TPair<double, FPairKey>> ScratchCandidates;
+
+	FPairState& FindOrAddPair(AActor* Observer, AActor* Target);
+	bool GetTracePoints(const FPairState& PairState, FVector& OutStart, FVector& OutEnd, FCollisionQueryParams& OutQueryParams) const;
+	bool IsLineOfSightHit(const FPairState& PairState, const TArray<FHitResult>& Hits) const;
+	void TraceImmediately(FPairState& PairState);
+	void OnTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+};
@@ -0,0 +1,128 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UHLNavDistanceFieldSubsystem.generated.h"
+
+class APawn;
+class ANavigationData;
+class ARecastNavMesh;
+
+USTRUCT(BlueprintType)
+struct FUHLNavDistanceFieldSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Nav Distance Field")
+	bool bEnable = false;
+
+	// Field rebuilt when player moved farther than this from field origin
+	UPROPERTY(EditAnywhere, Category = "Nav Distance Field", meta = (ClampMin = "0.0", Units = "Centimeters"))
+	float RebuildDistance = 200.0f;
+
+	// Polygons further than this from player not included in field
+	UPROPERTY(EditAnywhere, Category = "Nav Distance Field", meta = (ClampMin = "0.0", Units = "Centimeters"))
+	float MaxPathDistance = 10000.0f;
+
+	// Polygons expanded per frame for all players, rebuild spread over frames
+	UPROPERTY(EditAnywhere, Category = "Nav Distance Field", meta = (ClampMin = "1"))
+	int32 MaxPolysPerFrame = 1000;
+
+	// Queries "from location" use field of player standing closer than this to location
+	UPROPERTY(EditAnywhere, Category = "Nav Distance Field", meta = (ClampMin = "0.0", Units = "Centimeters"))
+	float OriginMatchTolerance = 250.0f;
+};
+
+/**
+ * Dijkstra field over navmesh polygons from every player pawn.
+ * Path distance and direction toward player for any point become lookup
+ * of nearest polygon instead of pathfinding, used by GetMostDistantVector(bUseNavigation).
+ *
+ * Rebuild time-sliced by "MaxPolysPerFrame", queries use previous field until new one finished.
+ * Distances go through polygon centers, so slightly longer than real path, it's fine for
+ * flee/kite/flank scoring but not for exact path length.
+ * Recast navmesh only, field invalidated when navmesh rebuilt.
+ */
+UCLASS()
+class UNREALHELPERLIBRARY_API UUHLNavDistanceFieldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Returns false if field not ready or location not reachable within MaxPathDistance
+	UFUNCTION(BlueprintCallable, Category = "UHL|NavDistanceField")
+	bool GetPathDistanceToPlayer(const APawn* Player, FVector Location, float& OutDistance) const;
+	// Direction of first path segment from Location toward player
+	UFUNCTION(BlueprintCallable, Category = "UHL|NavDistanceField")
+	bool GetDirectionToPlayer(const APawn* Player, FVector Location, FVector& OutDirection) const;
+	// Uses field of player standing at Origin (within OriginMatchTolerance), false if there is none
+	UFUNCTION(BlueprintCallable, Category = "UHL|NavDistanceField")
+	bool GetPathDistanceFromOrigin(FVector Origin, FVector Location, float& OutDistance) const;
+
+	UFUNCTION(BlueprintPure, Category = "UHL|NavDistanceField")
+	bool IsFieldReady(const APawn* Player) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FNode
+	{
+		float Distance = MAX_flt;
+		// next polygon toward origin
+		NavNodeRef Parent = INVALID_NAVNODEREF;
+	};
+
+	struct FOpenNode
+	{
+		float Distance;
+		NavNodeRef Poly;
+
+		bool operator<(const FOpenNode& Other) const { return Distance < Other.Distance; }
+	};
+
+	struct FFieldData
+	{
+		FVector Origin = FVector::ZeroVector;
+		NavNodeRef OriginPoly = INVALID_NAVNODEREF;
+		TMap<NavNodeRef, FNode> Nodes;
+	};
+
+	struct FField
+	{
+		TWeakObjectPtr<APawn> Player;
+		FFieldData Ready;
+		FFieldData Building;
+		TArray<FOpenNode> OpenHeap;
+		bool bHasReady = false;
+		bool bBuilding = false;
+	};
+
+	FUHLNavDistanceFieldSettings Settings;
+	TArray<FField> Fields;
+
+	mutable TMap<NavNodeRef, FVector> PolyCenters;
+	TArray<NavNodeRef> ScratchNeighbors;
+
+	ARecastNavMesh* GetNavMesh() const;
+	FVector GetPolyCenter(const ARecastNavMesh* NavMesh, NavNodeRef Poly) const;
+	const FField* FindField(const APawn* Player) const;
+
+	void UpdatePlayers();
+	void StartBuild(FField& Field, const FVector& Origin, const ARecastNavMesh* NavMesh);
+	// Returns number of expanded polygons
+	int32 ContinueBuild(FField& Field, const ARecastNavMesh* NavMesh, int32 Budget);
+
+	bool GetFieldDistance(const FField& Field, const FVector& Location, float& OutDistance) const;
+
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+};
@@ -0,0 +1,69 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UHLPerfCaptureSubsystem.generated.h"
+
+/**
+ * Unattended performance capture of current map, created only when game launched with "-UHLPerfCapture=<Name>".
+ * Used by Scripts/RunGymPerfCaptures.bat to benchmark plugin on shipped Gym maps headlessly.
+ *
+ * After warmup runs "-UHLPerfCaptureExec" console commands (";" separated) as scenario,
+ * records CSV profiler capture (if compiled with CSV_PROFILER) and own samples for
+ * "-UHLPerfCaptureDuration" seconds, writes summary and exits.
+ *
+ * Summary "<Name>_Summary.csv" - min/avg/median/p95/max of frame time, game thread time,
+ * used memory and every UHL debug graph metric (EnemyTickOptimizerMs, LineOfSightTraces, ...).
+ * Use "-benchmark -fps=30" so simulation is same between runs and results comparable.
+ *
+ * Command line:
+ * -UHLPerfCapture=<Name> -UHLPerfCaptureDuration=<Seconds, 30> -UHLPerfCaptureWarmup=<Seconds, 5>
+ * -UHLPerfCaptureExec="<Cmd1>;<Cmd2>" -UHLPerfCaptureOutput=<Dir, Saved/Profiling/UHLPerfCapture>
+ */
+UCLASS()
+class UNREALHELPERLIBRARY_API UUHLPerfCaptureSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	UFUNCTION(BlueprintPure, Category = "UHL|PerfCapture")
+	bool IsCapturing() const { return State == EState::Capturing; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	enum class EState : uint8
+	{
+		Warmup,
+		Capturing,
+		Done,
+	};
+
+	EState State = EState::Warmup;
+	FString CaptureName;
+	FString OutputDir;
+	TArray<FString> ScenarioCommands;
+	double WarmupTime = 5.0;
+	double Duration = 30.0;
+
+	double StateStartTime = 0.0;
+	double LastFrameTime = 0.0;
+
+	// metric name -> samples, frame/game thread/memory included
+	TMap<FName, TArray<float>> Samples;
+	FDelegateHandle DebugGraphHandle;
+
+	void StartCapture();
+	void FinishCapture();
+	void RecordSample(FName MetricName, float Value);
+	void WriteSummary() const;
+};
@@ -0,0 +1,62 @@
+// Pavel Penkov 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UnrealHelperLibrary.h"
+#include <atomic>
+
+/**
+ * Per call site state of UHL_LOG_RATE_LIMITED.
+ *
+ * First message in "UHL.Log.RateLimitInterval" window is logged, others are only counted
+ * and reported with next logged message, so warning fired per notify per frame across a crowd
+ * produces one line per window instead of hundreds. Lock-free, can be used from worker threads.
+ */
+struct UNREALHELPERLIBRARY_API FUHLLogRateLimiter
+{
+public:
+	FUHLLogRateLimiter(const ANSICHAR* InFile, int32 InLine)
+		: File(InFile), Line(InLine) {}
+
+	// Returns true if message should be logged now, SuppressedCount_Out - messages dropped since last logged one
+	bool ShouldLog(int32& SuppressedCount_Out);
+
+	// "File.cpp:Line" of call site
+	FString GetSite() const;
+
+	// 0 - rate limiting disabled
+	static float GetInterval();
+
+private:
+	const ANSICHAR* File = nullptr;
+	int32 Line = 0;
+
+	std::atomic<uint64> NextLogCycles = 0;
+	std::atomic<int32> SuppressedCount = 0;
+};
+
+#if NO_LOGGING
+#define UHL_LOG_RATE_LIMITED(Verbosity, Format, ...)
+#else
+/**
+ * UE_LOG to LogUnrealHelperLibrary limited to one message per "UHL.Log.RateLimitInterval" for this call site.
+ * Message is followed by structured fields: "| Site=File.cpp:Line Suppressed=N Window=Xs",
+ * Suppressed - how many messages from this site were dropped since previous logged one.
+ * Nothing is formatted when verbosity is suppressed or message is rate limited.
+ */
+#define UHL_LOG_RATE_LIMITED(Verbosity, Format, ...) \
+	do \
+	{ \
+		if (!LogUnrealHelperLibrary.IsSuppressed(ELogVerbosity::Verbosity)) \
+		{ \
+			static FUHLLogRateLimiter UHLLogRateLimiter(__FILE__, __LINE__); \
+			int32 UHLLogSuppressedCount = 0; \
+			if (UHLLogRateLimiter.ShouldLog(UHLLogSuppressedCount)) \
+			{ \
+				UE_LOG(LogUnrealHelperLibrary, Verbosity, TEXT("%s | Site=%s Suppressed=%d Window=%.1fs"), \
+					*FString::Printf(Format, ##__VA_ARGS__), *UHLLogRateLimiter.GetSite(), UHLLogSuppressedCount, FUHLLogRateLimiter::GetInterval()); \
+			} \
+		} \
+	} while (false)
+#endif
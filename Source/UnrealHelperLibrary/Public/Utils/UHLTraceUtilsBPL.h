@@ -44,6 +44,20 @@ public:
                                         FQuat Rot, FName ProfileName, const FCollisionQueryParams& QueryParams,
                                         bool bDrawDebug = false, float DrawTime = -1.0f,
                                         FColor HitColor = FColor::Red);
+    /**
+     * Tests N candidate locations for capsule fit, candidate valid if nothing blocks it.
+     * Candidates processed in chunks, chunk tested in parallel, stops after chunk
+     * where MaxValid valid candidates found (MaxValid <= 0 - test all).
+     * OutValidMask has one bit per tested candidate - shorter than Candidates on early exit.
+     * OutValidIndices (optional) - first MaxValid valid indices in candidates order.
+     * Returns number of valid candidates found
+     */
+    static int32 OverlapBlockingTestBatchByProfile(const UWorld* World, TConstArrayView<FTransform> Candidates, float Radius, float HalfHeight,
+                                        FName ProfileName, const FCollisionQueryParams& QueryParams,
+                                        TBitArray<>& OutValidMask, TArray<int32>* OutValidIndices = nullptr,
+                                        int32 MaxValid = 0, int32 ChunkSize = 32,
+                                        bool bDrawDebug = false, float DrawTime = -1.0f,
+                                        FColor HitColor = FColor::Red);
     static bool SweepCapsuleMultiByProfile(const UWorld* World, TArray<FHitResult>& OutHits, const FVector& Start,
                                    const FVector& End, float Radius, float HalfHeight,
                                    const FQuat& Rot, FName ProfileName,
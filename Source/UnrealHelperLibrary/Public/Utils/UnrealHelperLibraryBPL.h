@@ -71,14 +71,14 @@ public:
 	// TODO GetDistanceOperation - MostDistant/LeastDistant/Average/Medium/...
 	UFUNCTION(BlueprintPure, Category = "UnrealHelperLibrary", meta = (WorldContext = "WorldContextObject"))
 	static FVector GetMostDistantVector(const UObject* WorldContextObject,
-		const TArray<FVector> Vectors, FVector Location, 
+		const TArray<FVector>& Vectors, FVector Location, 
 		float& MaxDistance_Out, int32& Index_Out,
 		bool bUseNavigation = false,
 		const bool bDebug = false, const float DebugLifetime = -1);
 	
 	UFUNCTION(BlueprintPure, Category = "UnrealHelperLibrary", meta = (WorldContext = "WorldContextObject"))
 	static FVector GetMostDistantActorComponent(const UObject* WorldContextObject,
-		const TArray<USceneComponent*> SceneComponents, FVector Location, 
+		const TArray<USceneComponent*>& SceneComponents, FVector Location, 
 		float& MaxDistance_Out, int32& Index_Out,
 		bool bUseNavigation = false,
 		const bool bDebug = false, const float DebugLifetime = -1);
@@ -107,8 +107,9 @@ public:
 		const FString& H = "", const FString& I = "", const FString& J = "", float Duration = 2.0f, const FName Key = NAME_None, const bool bEnabled = true);
 	UFUNCTION(Category = "UnrealHelperLibrary", meta = (WorldContext = "WorldContextObject", Keywords = "UnrealHelperLibrary debug Development", AdvancedDisplay = "D,E,F,G,H,I,J,Duration"))
 	static void DebugPrintString(const UObject* WorldContextObject, const FString& A, float Duration = 2.0f, const FName Key = NAME_None, const bool bEnabled = true);
-	UFUNCTION(BlueprintCallable, Category = "UnrealHelperLibrary|Debug", meta = (Keywords = "UnrealHelperLibrary debug Development"))
-	static void DrawDebugBar();
+	// Pushes value to "MetricName" graph of UUHLDebugGraphSubsystem, no-op in shipping
+	UFUNCTION(BlueprintCallable, Category = "UnrealHelperLibrary|Debug", meta = (Keywords = "UnrealHelperLibrary debug Development graph", WorldContext = "WorldContextObject"))
+	static void DrawDebugBar(const UObject* WorldContextObject, FName MetricName, float Value);
 	/** ~Debug **/
 
 	/** Anims **/
@@ -271,7 +272,7 @@ public:
 	// static EUHLDirection AngleToDirection(const float AngleIn);
 
 	UFUNCTION(BlueprintPure, Category = "UnrealHelperLibrary|Angles", meta = (DefaultToSelf = "Actor", Keywords = "UnrealHelperLibrary angle distance"))
-	static bool IsOtherActorInAngle(AActor* Actor, AActor* OtherActor, TArray<FFloatRange> Ranges);
+	static bool IsOtherActorInAngle(AActor* Actor, AActor* OtherActor, const TArray<FFloatRange>& Ranges);
 	UFUNCTION(BlueprintPure, Category = "UnrealHelperLibrary|Angles", meta = (DefaultToSelf = "Character", Keywords = "UnrealHelperLibrary angle distance"))
 	static bool InRangeToOtherCharacter(ACharacter* Character, ACharacter* OtherCharacter, FFloatRange Range, bool bIncludeSelfCapsuleRadius, bool bIncludeTargetCapsuleRadius);
 	UFUNCTION(BlueprintPure, Category = "UnrealHelperLibrary|Angles", meta = (DefaultToSelf = "Character", Keywords = "UnrealHelperLibrary angle distance"))
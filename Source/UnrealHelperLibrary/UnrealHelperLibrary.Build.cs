@@ -46,7 +46,10 @@ public class UnrealHelperLibrary : ModuleRules
 				"UMG",
 				"AnimGraphRuntime",
 				"DeveloperSettings",
-				"NavigationSystem"
+				"NavigationSystem",
+				"SkeletalMerging",
+				"MeshDescription",
+				"StaticMeshDescription",
 				// ... add private dependencies that you statically link with here ...
 			}
 			);